@@ -5,14 +5,12 @@
  */
 void generate_children(struct TreeNode* node, int goal[MAX_SIZE][MAX_SIZE], 
                       int n, HeuristicType heuristic_type) {
-    // Possible moves: up, down, left, right
-    int moves[4][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
-    
     node->num_children = 0;
     
-    for (int i = 0; i < 4; i++) {
-        int new_row = node->empty_row + moves[i][0];
-        int new_col = node->empty_col + moves[i][1];
+    // Possible moves: up, down, left, right
+    for (int i = 0; i < NUM_MOVES; i++) {
+        int new_row = node->empty_row + MOVE_DELTAS[i][0];
+        int new_col = node->empty_col + MOVE_DELTAS[i][1];
         
         // Check if the move is valid
         if (is_valid_move(new_row, new_col, n)) {
@@ -85,8 +83,7 @@ bool is_in_closed_list(struct TreeNode** closed_list, int closed_count,
 struct TreeNode* a_star_search(int initial[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE], 
                               int n, HeuristicType heuristic_type) {
     printf("\n=== Starting A* Search ===\n");
-    printf("Heuristic: %s\n", 
-           (heuristic_type == TILES_OUT_OF_PLACE) ? "Tiles Out of Place" : "Manhattan Distance");
+    printf("Heuristic: %s\n", heuristic_name(heuristic_type));
     printf("Puzzle size: %dx%d\n\n", n, n);
     
     // Check if initial state is already the goal state
@@ -0,0 +1,203 @@
+#include "npuzzle.h"
+
+// Running totals for one algorithm over a batch
+struct BatchTotals {
+    long solved;
+    long total_moves;
+    long nodes_expanded;
+    long nodes_generated;
+    long nodes_stored;
+    long heuristic_evaluations;
+    long lazy_reinsertions;
+    long verify_failures;            // Solutions that do not replay to the goal
+    long peak_open;                  // Largest open list of any instance
+    size_t peak_memory;              // Largest search memory of any instance
+    double seconds;
+};
+
+void add_to_totals(struct BatchTotals* totals, const struct SolveResult* result) {
+    if (result->status == SOLVE_FOUND) {
+        totals->solved++;
+        totals->total_moves += result->length;
+    }
+    totals->nodes_expanded += result->nodes_expanded;
+    totals->nodes_generated += result->nodes_generated;
+    totals->nodes_stored += result->nodes_stored;
+    totals->heuristic_evaluations += result->heuristic_evaluations;
+    totals->lazy_reinsertions += result->lazy_reinsertions;
+    if (result->peak_open > totals->peak_open) totals->peak_open = result->peak_open;
+    if (result->memory_bytes > totals->peak_memory) totals->peak_memory = result->memory_bytes;
+    totals->seconds += result->elapsed_seconds;
+}
+
+void print_batch_totals(const char* title, const struct BatchTotals* totals, uint64_t count) {
+    printf("\n=== BATCH STATISTICS (%s) ===\n", title);
+    printf("Instances: %llu\n", (unsigned long long)count);
+    printf("Solved: %ld\n", totals->solved);
+    if (totals->solved > 0) {
+        printf("Mean solution length: %.2f moves\n", (double)totals->total_moves / totals->solved);
+    }
+    printf("Nodes expanded: %ld\n", totals->nodes_expanded);
+    printf("Nodes generated: %ld\n", totals->nodes_generated);
+    printf("Nodes stored: %ld\n", totals->nodes_stored);
+    printf("Full heuristic evaluations: %ld\n", totals->heuristic_evaluations);
+    printf("Lazy re-insertions: %ld\n", totals->lazy_reinsertions);
+    printf("Verification failures: %ld\n", totals->verify_failures);
+    printf("Peak open list: %ld\n", totals->peak_open);
+    printf("Peak search memory: %.1f KiB\n", totals->peak_memory / 1024.0);
+    printf("Solve time: %.3f s\n", totals->seconds);
+    if (totals->seconds > 0) {
+        printf("Throughput: %.1f instances/s, %.0f nodes/s\n", count / totals->seconds,
+               totals->nodes_expanded / totals->seconds);
+    }
+}
+
+double percent_saved(double baseline, double value) {
+    return baseline > 0 ? 100.0 * (baseline - value) / baseline : 0.0;
+}
+
+/**
+ * Command line entry: npuzzle --batch FILE [--heuristic NAME] [--algorithm astar|epea|compare]
+ *                                          [--lazy] [--max-nodes N] [--limit K] [--per-instance]
+ *                                          [--perimeter R]
+ * Streams every instance of a mapped corpus through the solver and reports
+ * throughput, acting as both batch solver and benchmark harness
+ */
+int run_batch_command(int argc, char* argv[]) {
+    const char* path = NULL;
+    const char* heuristic = "manhattan";
+    const char* algorithm = "astar";
+    unsigned long long limit = 0;
+    bool per_instance = false;
+    int perimeter_radius = -1;
+    struct SolveOptions options;
+    memset(&options, 0, sizeof(options));
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--batch") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (strcmp(argv[i], "--heuristic") == 0 && i + 1 < argc) {
+            heuristic = argv[++i];
+        } else if (strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+            algorithm = argv[++i];
+        } else if (strcmp(argv[i], "--lazy") == 0) {
+            options.lazy_heuristic = true;
+        } else if (strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+            options.max_nodes = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            limit = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--per-instance") == 0) {
+            per_instance = true;
+        } else if (strcmp(argv[i], "--perimeter") == 0 && i + 1 < argc) {
+            perimeter_radius = atoi(argv[++i]);
+        } else {
+            printf("Unknown batch option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    // "compare" runs plain A* and EPEA* on every instance
+    HeuristicType heuristic_type;
+    bool compare = strcmp(algorithm, "compare") == 0;
+    if (!path || !parse_heuristic_name(heuristic, &heuristic_type) ||
+        (!compare && !parse_algorithm_name(algorithm, &options.algorithm)) ||
+        perimeter_radius < -1 || perimeter_radius > MAX_PERIMETER_RADIUS) {
+        printf("Usage: npuzzle --batch FILE [--heuristic tiles|manhattan|linear] [--algorithm astar|epea|compare]\n"
+               "                [--lazy] [--max-nodes N] [--limit K] [--per-instance] [--perimeter R]\n");
+        return 1;
+    }
+
+    struct Corpus corpus;
+    if (!corpus_open(&corpus, path)) return 1;
+
+    int n = (int)corpus.header->n;
+    int goal[MAX_SIZE][MAX_SIZE];
+    struct HeuristicTables tables;
+    unpack_state(corpus.header->goal, goal, n);
+    build_heuristic_tables(&tables, goal, n);
+
+    struct Perimeter perimeter;
+    double perimeter_seconds = 0.0;
+    if (perimeter_radius >= 0) {
+        double build_start = monotonic_seconds();
+        if (!build_perimeter(&perimeter, tables.goal, n, perimeter_radius)) {
+            printf("Cannot build a perimeter of radius %d: over %u states or out of memory\n",
+                   perimeter_radius, PERIMETER_MAX_STATES);
+            corpus_close(&corpus);
+            return 1;
+        }
+        perimeter_seconds = monotonic_seconds() - build_start;
+        options.perimeter = &perimeter;
+    }
+
+    uint64_t count = corpus.count;
+    if (limit > 0 && limit < count) count = limit;
+
+    int num_runs = compare ? 2 : 1;
+    SearchAlgorithm runs[2] = {compare ? SEARCH_ASTAR : options.algorithm, SEARCH_EPEA};
+    struct BatchTotals totals[2];
+    memset(totals, 0, sizeof(totals));
+    long mismatches = 0;
+
+    printf("=== Batch Solve ===\n");
+    printf("Corpus: %s (%llu %dx%d instances)\n", path, (unsigned long long)corpus.count, n, n);
+    printf("Heuristic: %s\n", heuristic_name(heuristic_type));
+    printf("Algorithm: %s%s\n", algorithm, options.lazy_heuristic ? " (lazy heuristic)" : "");
+    if (options.perimeter) {
+        printf("Perimeter: radius %d, %zu states, built in %.3f s\n", perimeter.radius, perimeter.count,
+               perimeter_seconds);
+    }
+    if (per_instance) {
+        printf("index,algorithm,status,length,expanded,generated,stored,seconds\n");
+    }
+
+    for (uint64_t i = 0; i < count; i++) {
+        int puzzle[MAX_SIZE][MAX_SIZE];
+        int lengths[2] = {0, 0};
+        unpack_state(corpus.records[i], puzzle, n);
+
+        for (int r = 0; r < num_runs; r++) {
+            struct SolveResult result;
+            options.algorithm = runs[r];
+            solve_puzzle(&tables, puzzle, heuristic_type, &options, &result);
+            add_to_totals(&totals[r], &result);
+            lengths[r] = result.length;
+            if (result.status == SOLVE_FOUND &&
+                !verify_solution(corpus.records[i], tables.goal, result.moves, result.length, n)) {
+                totals[r].verify_failures++;
+            }
+
+            if (per_instance) {
+                printf("%llu,%s,%s,%d,%ld,%ld,%ld,%.6f\n", (unsigned long long)i, algorithm_name(runs[r]),
+                       solve_status_name(result.status), result.length, result.nodes_expanded,
+                       result.nodes_generated, result.nodes_stored, result.elapsed_seconds);
+            }
+            free_solve_result(&result);
+        }
+
+        if (compare && lengths[0] != lengths[1]) mismatches++;
+    }
+
+    corpus_close(&corpus);
+    if (options.perimeter) free_perimeter(&perimeter);
+
+    for (int r = 0; r < num_runs; r++) {
+        print_batch_totals(algorithm_name(runs[r]), &totals[r], count);
+    }
+
+    if (compare) {
+        printf("\n=== EPEA* SAVINGS VS A* ===\n");
+        printf("Nodes stored: %.1f%% fewer\n", percent_saved(totals[0].nodes_stored, totals[1].nodes_stored));
+        printf("Nodes generated: %.1f%% fewer\n",
+               percent_saved(totals[0].nodes_generated, totals[1].nodes_generated));
+        printf("Peak open list: %.1f%% smaller\n", percent_saved(totals[0].peak_open, totals[1].peak_open));
+        printf("Peak search memory: %.1f%% smaller\n",
+               percent_saved((double)totals[0].peak_memory, (double)totals[1].peak_memory));
+        printf("Solve time saved: %.1f%%\n", percent_saved(totals[0].seconds, totals[1].seconds));
+        printf("Solution length mismatches: %ld\n", mismatches);
+    }
+
+    bool all_solved = totals[0].solved == (long)count && (!compare || totals[1].solved == (long)count);
+    bool all_verified = totals[0].verify_failures == 0 && totals[1].verify_failures == 0;
+    return all_solved && all_verified && mismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,196 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include "npuzzle.h"
+
+/*
+ * Search checkpoints.
+ *
+ * A checkpoint is a CheckpointHeader followed by the node pool and the
+ * open list of a search, copied as they are in memory (host byte order).
+ * Nodes link to their parents by index, so the pool needs no fix-ups; the
+ * hash table is not saved and is rebuilt from the pool when loading.
+ *
+ * Periodic snapshots are written by a forked child: fork() gives it a
+ * copy-on-write image of the search, so the solver only pauses for the
+ * fork itself while the child writes to a temporary file and renames it
+ * over the checkpoint. The child sticks to open/write/rename/_exit, which
+ * are safe after forking a multi-threaded process. A crash at any moment
+ * leaves either the previous or the new checkpoint, never a partial one.
+ */
+
+bool write_all(int fd, const void* data, size_t size) {
+    const char* p = (const char*)data;
+    while (size > 0) {
+        ssize_t written = write(fd, p, size);
+        if (written < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        p += written;
+        size -= (size_t)written;
+    }
+    return true;
+}
+
+/**
+ * Writes a checkpoint to path via a temporary file and an atomic rename
+ * Uses only async-signal-safe calls so that forked writers can run it
+ */
+bool write_checkpoint_file(const char* path, const struct CheckpointHeader* header,
+                           const struct SearchSpace* space) {
+    char temp_path[4096];
+    size_t length = strlen(path);
+    if (length + 5 > sizeof(temp_path)) return false;
+    memcpy(temp_path, path, length);
+    memcpy(temp_path + length, ".tmp", 5);
+
+    int fd = open(temp_path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    bool ok = write_all(fd, header, sizeof(*header)) &&
+              write_all(fd, space->nodes, header->node_count * sizeof(struct SearchNode)) &&
+              write_all(fd, space->open, header->open_count * sizeof(struct OpenEntry)) &&
+              fsync(fd) == 0;
+    ok = (close(fd) == 0) && ok;
+    if (!ok || rename(temp_path, path) != 0) {
+        unlink(temp_path);
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Collects a finished writer; with wait set, blocks until it exits
+ */
+void finish_checkpoint(struct CheckpointWriter* writer, bool wait) {
+    if (writer->pid == 0) return;
+
+    int status;
+    pid_t done = waitpid((pid_t)writer->pid, &status, wait ? 0 : WNOHANG);
+    if (done == 0) return;           // Still writing
+    if (done == (pid_t)writer->pid && WIFEXITED(status) && WEXITSTATUS(status) == 0) {
+        writer->completed++;
+    }
+    writer->pid = 0;
+}
+
+/**
+ * Starts writing a snapshot of the search in a forked child
+ * Returns false if the previous snapshot is still being written or fork failed
+ */
+bool start_checkpoint(struct CheckpointWriter* writer, const char* path,
+                      const struct CheckpointHeader* header, const struct SearchSpace* space) {
+    finish_checkpoint(writer, false);
+    if (writer->pid != 0) return false;
+
+    pid_t pid = fork();
+    if (pid < 0) return false;
+    if (pid == 0) {
+        _exit(write_checkpoint_file(path, header, space) ? 0 : 1);
+    }
+    writer->pid = (long)pid;
+    return true;
+}
+
+/**
+ * Reads and validates the header of a checkpoint file
+ * The file must hold exactly the nodes and open entries the header counts,
+ * so a corrupt count is rejected before anything is allocated for it
+ */
+bool read_checkpoint_header(const char* path, struct CheckpointHeader* header) {
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+
+    struct stat info;
+    bool ok = fread(header, sizeof(*header), 1, fp) == 1 && fstat(fileno(fp), &info) == 0 &&
+              memcmp(header->magic, CHECKPOINT_MAGIC, sizeof(header->magic)) == 0 &&
+              header->version == CHECKPOINT_VERSION && header->header_size == sizeof(*header) &&
+              header->node_size == sizeof(struct SearchNode) &&
+              header->open_entry_size == sizeof(struct OpenEntry) &&
+              header->n >= 2 && header->n <= MAX_SIZE && header->node_count > 0 &&
+              header->node_count < UINT32_MAX && is_permutation_state(header->initial, (int)header->n) &&
+              is_permutation_state(header->goal, (int)header->n);
+    fclose(fp);
+    if (!ok) return false;
+
+    // Node counts are below 2^32, so only the open count can overflow the sum
+    uint64_t file_size = (uint64_t)info.st_size;
+    uint64_t fixed_size = header->header_size + header->node_count * header->node_size;
+    return file_size >= fixed_size && (file_size - fixed_size) % header->open_entry_size == 0 &&
+           header->open_count == (file_size - fixed_size) / header->open_entry_size;
+}
+
+/**
+ * Checks that a node is the root of the saved search or one move away from its parent
+ * Every node's state and blank must already have been checked
+ */
+bool valid_checkpoint_node(const struct SearchNode* nodes, size_t node_count, size_t index,
+                           const struct CheckpointHeader* header) {
+    const struct SearchNode* node = &nodes[index];
+    if (node->parent == UINT32_MAX) {
+        return node->state == header->initial && node->g == 0 && node->move == NO_MOVE;
+    }
+    if (node->parent >= node_count || node->move >= NUM_MOVES) return false;
+
+    // g grows by one along every link, which also rules out parent cycles
+    const struct SearchNode* parent = &nodes[node->parent];
+    PackedState state;
+    int blank;
+    return node->g == parent->g + 1 &&
+           packed_move(parent->state, parent->blank, node->move, (int)header->n, &state, &blank) &&
+           state == node->state;
+}
+
+/**
+ * Loads a checkpoint into an initialized search space and rebuilds its hash table
+ * Returns false if the file is invalid or, with space->out_of_memory set, too large to load
+ */
+bool load_checkpoint(const char* path, struct SearchSpace* space, struct CheckpointHeader* header) {
+    if (!read_checkpoint_header(path, header)) return false;
+
+    FILE* fp = fopen(path, "rb");
+    if (!fp) return false;
+
+    size_t node_count = (size_t)header->node_count;
+    size_t open_count = (size_t)header->open_count;
+    if (!search_space_reserve(space, node_count, open_count)) {
+        fclose(fp);
+        return false;
+    }
+
+    bool ok = fseek(fp, (long)header->header_size, SEEK_SET) == 0 &&
+              fread(space->nodes, sizeof(struct SearchNode), node_count, fp) == node_count &&
+              fread(space->open, sizeof(struct OpenEntry), open_count, fp) == open_count;
+    fclose(fp);
+    if (!ok) return false;
+
+    // Reject links that would send the search outside the pool, then any node
+    // whose blank, move or cost would be trusted into out-of-range lookups
+    for (size_t i = 0; i < open_count; i++) {
+        if (space->open[i].node >= node_count) return false;
+    }
+    for (size_t i = 0; i < node_count; i++) {
+        const struct SearchNode* node = &space->nodes[i];
+        if (!is_permutation_state(node->state, (int)header->n) ||
+            node->blank != packed_blank_cell(node->state, (int)header->n)) {
+            return false;
+        }
+    }
+    for (size_t i = 0; i < node_count; i++) {
+        if (!valid_checkpoint_node(space->nodes, node_count, i, header)) return false;
+    }
+
+    if (!state_index_resize(&space->index, space->nodes, node_count, node_count)) {
+        space->out_of_memory = true;
+        return false;
+    }
+    space->node_count = node_count;
+    space->open_count = open_count;
+    return true;
+}
@@ -0,0 +1,128 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "npuzzle.h"
+
+/*
+ * Packed instance corpus files.
+ *
+ * A corpus is a fixed 64-byte CorpusHeader followed by count fixed-size
+ * records, each one PackedState in host byte order. Readers map the file
+ * and walk the record array in place, so streaming millions of instances
+ * costs no parsing and no copies; opening checks each record once.
+ */
+
+/**
+ * Maps a corpus file read-only and validates its header, goal and records
+ */
+bool corpus_open(struct Corpus* corpus, const char* path) {
+    struct stat info;
+    memset(corpus, 0, sizeof(*corpus));
+    corpus->fd = -1;
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        printf("Cannot open corpus %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    if (fstat(fd, &info) != 0 || (size_t)info.st_size < sizeof(struct CorpusHeader)) {
+        printf("Corpus %s is too short.\n", path);
+        close(fd);
+        return false;
+    }
+
+    void* map = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        printf("Cannot map corpus %s: %s\n", path, strerror(errno));
+        close(fd);
+        return false;
+    }
+    posix_madvise(map, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+
+    // Records must be aligned for in-place access, and the count is checked
+    // by division so that a corrupt value cannot overflow the size sum
+    const struct CorpusHeader* header = (const struct CorpusHeader*)map;
+    uint64_t file_size = (uint64_t)info.st_size;
+    if (memcmp(header->magic, CORPUS_MAGIC, sizeof(header->magic)) != 0 ||
+        header->version != CORPUS_VERSION || header->record_size != sizeof(PackedState) ||
+        header->header_size < sizeof(struct CorpusHeader) || header->header_size % sizeof(PackedState) != 0 ||
+        header->header_size > file_size || header->n < 2 || header->n > MAX_SIZE ||
+        header->count > (file_size - header->header_size) / header->record_size) {
+        printf("Corpus %s has an invalid header.\n", path);
+        munmap(map, (size_t)info.st_size);
+        close(fd);
+        return false;
+    }
+
+    // Solvers index heuristic tables by tile and hash whole states, so every
+    // board must be a permutation of the tiles before anything is solved
+    const PackedState* records = (const PackedState*)((const char*)map + header->header_size);
+    bool valid = is_permutation_state(header->goal, (int)header->n);
+    if (!valid) {
+        printf("Corpus %s has an invalid goal state.\n", path);
+    }
+    for (uint64_t i = 0; valid && i < header->count; i++) {
+        if (!is_permutation_state(records[i], (int)header->n)) {
+            printf("Corpus %s has an invalid state in record %llu.\n", path, (unsigned long long)i);
+            valid = false;
+        }
+    }
+    if (!valid) {
+        munmap(map, (size_t)info.st_size);
+        close(fd);
+        return false;
+    }
+
+    corpus->fd = fd;
+    corpus->map_size = (size_t)info.st_size;
+    corpus->header = header;
+    corpus->records = records;
+    corpus->count = header->count;
+    return true;
+}
+
+void corpus_close(struct Corpus* corpus) {
+    if (corpus->header) {
+        munmap((void*)corpus->header, corpus->map_size);
+    }
+    if (corpus->fd >= 0) {
+        close(corpus->fd);
+    }
+    memset(corpus, 0, sizeof(*corpus));
+    corpus->fd = -1;
+}
+
+/**
+ * Creates a corpus file and writes a provisional header
+ * Records are then appended with fwrite and the header completed by corpus_finish
+ */
+FILE* corpus_create(const char* path, const struct CorpusHeader* header) {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        printf("Cannot create corpus %s: %s\n", path, strerror(errno));
+        return NULL;
+    }
+    if (fwrite(header, sizeof(*header), 1, fp) != 1) {
+        printf("Cannot write corpus header: %s\n", strerror(errno));
+        fclose(fp);
+        return NULL;
+    }
+    return fp;
+}
+
+/**
+ * Rewrites the header with the final record count and closes the file
+ */
+bool corpus_finish(FILE* fp, struct CorpusHeader* header, uint64_t count) {
+    header->count = count;
+    bool ok = fseek(fp, 0, SEEK_SET) == 0 && fwrite(header, sizeof(*header), 1, fp) == 1;
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok) {
+        printf("Cannot finish corpus: %s\n", strerror(errno));
+    }
+    return ok;
+}
@@ -0,0 +1,596 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <ctype.h>
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "npuzzle.h"
+
+#define DAEMON_MAX_LINE 512
+#define DAEMON_LATENCY_WINDOW 65536
+#define DAEMON_DEFAULT_WORKERS 4
+#define DAEMON_DEFAULT_MAX_NODES 20000000L
+#define DAEMON_MAX_IN_FLIGHT 64
+
+/*
+ * Resident solver daemon.
+ *
+ * Heuristic tables for every board size (and, with --perimeter, the
+ * perimeter around each goal, capped per size to the layers that fit
+ * in PERIMETER_MAX_STATES) are built once at startup and shared
+ * read-only by a pool of worker threads. Clients talk a line
+ * protocol over a Unix-domain socket:
+ *
+ *   SOLVE <heuristic> <n> <tile> ... <tile>
+ *       -> OK <length> <moves|-> <expanded> <micros>
+ *       -> FAIL <status> <expanded> <micros>
+ *   STATS -> STATS requests=.. errors=.. p50_us=.. p90_us=.. p99_us=.. max_us=..
+ *   PING  -> PONG
+ *   QUIT  -> connection closed once earlier replies are sent
+ *   anything else -> ERR <message>
+ *
+ * Requests may be pipelined: a connection can send lines without waiting.
+ * They are solved concurrently by the pool, and replies are written back in
+ * request order by a writer thread per connection, so workers never block
+ * on a client. Once DAEMON_MAX_IN_FLIGHT requests of a connection are
+ * unsent, its reader stops reading until the writer catches up.
+ */
+
+struct DaemonConnection;
+
+// One request line travelling through the worker pool
+struct DaemonJob {
+    struct DaemonConnection* conn;
+    char line[DAEMON_MAX_LINE];
+    char reply[DAEMON_MAX_LINE + 128];
+    bool done;
+    double enqueued_at;
+    struct DaemonJob* next_in_queue; // Global work queue link
+    struct DaemonJob* next_in_conn;  // Per-connection reply order link
+};
+
+// Client connection; freed once its reader and writer threads are done
+struct DaemonConnection {
+    int fd;
+    pthread_mutex_t lock;
+    pthread_cond_t reply_ready;      // Oldest request answered, or reading done
+    pthread_cond_t slot_free;        // Replies sent, so in_flight went down
+    struct DaemonJob* reply_head;    // Oldest unsent request
+    struct DaemonJob* reply_tail;
+    int in_flight;                   // Requests submitted but not yet sent
+    bool reading_done;               // Reader saw QUIT or end of stream
+    int refs;                        // Reader and writer threads
+};
+
+// Shared daemon state
+struct DaemonState {
+    struct HeuristicTables tables[MAX_SIZE + 1];
+    struct Perimeter perimeters[MAX_SIZE + 1];
+    int perimeter_radius;            // -1 without perimeters
+    struct SolveOptions options;
+
+    pthread_mutex_t queue_lock;
+    pthread_cond_t queue_ready;
+    struct DaemonJob* queue_head;
+    struct DaemonJob* queue_tail;
+    bool stopping;
+
+    pthread_mutex_t stats_lock;
+    long requests;
+    long errors;
+    double latencies_us[DAEMON_LATENCY_WINDOW];  // Ring of recent SOLVE latencies
+    long latency_count;
+};
+
+struct DaemonState daemon_state;
+volatile sig_atomic_t daemon_stop_requested = 0;
+int daemon_listen_fd = -1;
+
+void daemon_handle_signal(int signum) {
+    (void)signum;
+    daemon_stop_requested = 1;
+    if (daemon_listen_fd >= 0) {
+        shutdown(daemon_listen_fd, SHUT_RDWR);
+    }
+}
+
+/**
+ * Writes a whole buffer to a socket
+ * Returns false if the peer went away
+ */
+bool daemon_write_all(int fd, const char* data, size_t len) {
+    while (len > 0) {
+        ssize_t sent = write(fd, data, len);
+        if (sent < 0) {
+            if (errno == EINTR) continue;
+            return false;
+        }
+        data += sent;
+        len -= (size_t)sent;
+    }
+    return true;
+}
+
+/**
+ * Drops one reference to a connection, closing it with the last one
+ */
+void daemon_release_connection(struct DaemonConnection* conn) {
+    pthread_mutex_lock(&conn->lock);
+    bool last = (--conn->refs == 0);
+    pthread_mutex_unlock(&conn->lock);
+
+    if (last) {
+        close(conn->fd);
+        pthread_cond_destroy(&conn->reply_ready);
+        pthread_cond_destroy(&conn->slot_free);
+        pthread_mutex_destroy(&conn->lock);
+        free(conn);
+    }
+}
+
+int compare_doubles(const void* a, const void* b) {
+    double x = *(const double*)a;
+    double y = *(const double*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Formats request counters and latency percentiles over the recent window
+ */
+void daemon_format_stats(char* out, size_t size) {
+    pthread_mutex_lock(&daemon_state.stats_lock);
+    long count = daemon_state.latency_count < DAEMON_LATENCY_WINDOW
+                 ? daemon_state.latency_count : DAEMON_LATENCY_WINDOW;
+    double* sorted = (double*)malloc((count > 0 ? count : 1) * sizeof(double));
+    if (sorted) {
+        memcpy(sorted, daemon_state.latencies_us, count * sizeof(double));
+    }
+    long requests = daemon_state.requests;
+    long errors = daemon_state.errors;
+    pthread_mutex_unlock(&daemon_state.stats_lock);
+
+    if (!sorted) {
+        snprintf(out, size, "ERR out of memory\n");
+        return;
+    }
+
+    double p50 = 0, p90 = 0, p99 = 0, max = 0;
+    if (count > 0) {
+        qsort(sorted, count, sizeof(double), compare_doubles);
+        p50 = sorted[(count - 1) * 50 / 100];
+        p90 = sorted[(count - 1) * 90 / 100];
+        p99 = sorted[(count - 1) * 99 / 100];
+        max = sorted[count - 1];
+    }
+    free(sorted);
+
+    snprintf(out, size, "STATS requests=%ld errors=%ld window=%ld p50_us=%.0f p90_us=%.0f p99_us=%.0f max_us=%.0f\n",
+             requests, errors, count, p50, p90, p99, max);
+}
+
+/**
+ * Parses and runs a SOLVE request, filling in the reply line
+ */
+bool daemon_solve(const char* args, char* reply, size_t size) {
+    char name[32];
+    int n, consumed;
+    HeuristicType heuristic_type;
+
+    if (sscanf(args, "%31s %d%n", name, &n, &consumed) != 2 || !parse_heuristic_name(name, &heuristic_type)) {
+        snprintf(reply, size, "ERR usage: SOLVE <tiles|manhattan|linear> <n> <tiles...>\n");
+        return false;
+    }
+    if (n < 2 || n > MAX_SIZE) {
+        snprintf(reply, size, "ERR size must be between 2 and %d\n", MAX_SIZE);
+        return false;
+    }
+
+    int puzzle[MAX_SIZE][MAX_SIZE];
+    bool seen[MAX_SIZE * MAX_SIZE] = {false};
+    const char* p = args + consumed;
+    for (int cell = 0; cell < n * n; cell++) {
+        int value, used;
+        if (sscanf(p, "%d%n", &value, &used) != 1 || value < 0 || value >= n * n || seen[value]) {
+            snprintf(reply, size, "ERR invalid board\n");
+            return false;
+        }
+        seen[value] = true;
+        puzzle[cell / n][cell % n] = value;
+        p += used;
+    }
+    while (isspace((unsigned char)*p)) p++;
+    if (*p != '\0') {
+        snprintf(reply, size, "ERR expected %d tiles\n", n * n);
+        return false;
+    }
+
+    struct SolveResult result;
+    struct SolveOptions options = daemon_state.options;
+    if (daemon_state.perimeter_radius >= 0) options.perimeter = &daemon_state.perimeters[n];
+    solve_puzzle(&daemon_state.tables[n], puzzle, heuristic_type, &options, &result);
+
+    if (result.status == SOLVE_FOUND) {
+        snprintf(reply, size, "OK %d %s %ld %.0f\n", result.length,
+                 result.length > 0 ? result.moves : "-", result.nodes_expanded,
+                 result.elapsed_seconds * 1e6);
+    } else {
+        snprintf(reply, size, "FAIL %s %ld %.0f\n", solve_status_name(result.status),
+                 result.nodes_expanded, result.elapsed_seconds * 1e6);
+    }
+    free_solve_result(&result);
+    return true;
+}
+
+/**
+ * Handles one request line and records its latency
+ */
+void daemon_process_job(struct DaemonJob* job) {
+    bool ok = true;
+    bool is_solve = false;
+
+    if (strncmp(job->line, "SOLVE ", 6) == 0) {
+        is_solve = true;
+        ok = daemon_solve(job->line + 6, job->reply, sizeof(job->reply));
+    } else if (strcmp(job->line, "STATS") == 0) {
+        daemon_format_stats(job->reply, sizeof(job->reply));
+    } else if (strcmp(job->line, "PING") == 0) {
+        snprintf(job->reply, sizeof(job->reply), "PONG\n");
+    } else {
+        ok = false;
+        snprintf(job->reply, sizeof(job->reply), "ERR unknown command\n");
+    }
+
+    double latency_us = (monotonic_seconds() - job->enqueued_at) * 1e6;
+
+    pthread_mutex_lock(&daemon_state.stats_lock);
+    daemon_state.requests++;
+    if (!ok) daemon_state.errors++;
+    if (is_solve) {
+        daemon_state.latencies_us[daemon_state.latency_count % DAEMON_LATENCY_WINDOW] = latency_us;
+        daemon_state.latency_count++;
+    }
+    pthread_mutex_unlock(&daemon_state.stats_lock);
+}
+
+/**
+ * Marks a job finished and wakes the connection's writer if its reply is next
+ */
+void daemon_complete_job(struct DaemonJob* job) {
+    struct DaemonConnection* conn = job->conn;
+
+    pthread_mutex_lock(&conn->lock);
+    job->done = true;
+    if (conn->reply_head == job) {
+        pthread_cond_signal(&conn->reply_ready);
+    }
+    pthread_mutex_unlock(&conn->lock);
+}
+
+/**
+ * Sends the replies of one client in request order until its reader is done
+ * and every request is answered. This is the only thread writing to the
+ * socket, so a client that stops reading stalls nobody but itself.
+ */
+void* daemon_writer(void* arg) {
+    struct DaemonConnection* conn = (struct DaemonConnection*)arg;
+    bool connected = true;
+
+    pthread_mutex_lock(&conn->lock);
+    while (true) {
+        while (!(conn->reply_head && conn->reply_head->done) &&
+               !(conn->reading_done && !conn->reply_head)) {
+            pthread_cond_wait(&conn->reply_ready, &conn->lock);
+        }
+        if (!conn->reply_head) break;
+
+        // Detach every reply that is now in order and send them unlocked
+        struct DaemonJob* ready = conn->reply_head;
+        struct DaemonJob* last = ready;
+        int count = 1;
+        while (last->next_in_conn && last->next_in_conn->done) {
+            last = last->next_in_conn;
+            count++;
+        }
+        conn->reply_head = last->next_in_conn;
+        if (!conn->reply_head) conn->reply_tail = NULL;
+        last->next_in_conn = NULL;
+        pthread_mutex_unlock(&conn->lock);
+
+        while (ready) {
+            struct DaemonJob* next = ready->next_in_conn;
+            // After a failed write the replies are only discarded
+            if (connected) connected = daemon_write_all(conn->fd, ready->reply, strlen(ready->reply));
+            free(ready);
+            ready = next;
+        }
+
+        pthread_mutex_lock(&conn->lock);
+        conn->in_flight -= count;
+        pthread_cond_signal(&conn->slot_free);
+    }
+    pthread_mutex_unlock(&conn->lock);
+
+    daemon_release_connection(conn);
+    return NULL;
+}
+
+void* daemon_worker(void* arg) {
+    (void)arg;
+
+    while (true) {
+        pthread_mutex_lock(&daemon_state.queue_lock);
+        while (!daemon_state.queue_head && !daemon_state.stopping) {
+            pthread_cond_wait(&daemon_state.queue_ready, &daemon_state.queue_lock);
+        }
+        if (!daemon_state.queue_head) {
+            pthread_mutex_unlock(&daemon_state.queue_lock);
+            return NULL;
+        }
+        struct DaemonJob* job = daemon_state.queue_head;
+        daemon_state.queue_head = job->next_in_queue;
+        if (!daemon_state.queue_head) daemon_state.queue_tail = NULL;
+        pthread_mutex_unlock(&daemon_state.queue_lock);
+
+        daemon_process_job(job);
+        daemon_complete_job(job);
+    }
+}
+
+/**
+ * Queues a request line, reserving its slot in the connection's reply order
+ * Blocks while the connection already has DAEMON_MAX_IN_FLIGHT unsent requests
+ */
+void daemon_submit(struct DaemonConnection* conn, const char* line) {
+    struct DaemonJob* job = (struct DaemonJob*)calloc(1, sizeof(struct DaemonJob));
+    if (!job) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    job->conn = conn;
+    snprintf(job->line, sizeof(job->line), "%s", line);
+    job->enqueued_at = monotonic_seconds();
+
+    pthread_mutex_lock(&conn->lock);
+    while (conn->in_flight >= DAEMON_MAX_IN_FLIGHT) {
+        pthread_cond_wait(&conn->slot_free, &conn->lock);
+    }
+    conn->in_flight++;
+    if (conn->reply_tail) {
+        conn->reply_tail->next_in_conn = job;
+    } else {
+        conn->reply_head = job;
+    }
+    conn->reply_tail = job;
+    pthread_mutex_unlock(&conn->lock);
+
+    pthread_mutex_lock(&daemon_state.queue_lock);
+    if (daemon_state.queue_tail) {
+        daemon_state.queue_tail->next_in_queue = job;
+    } else {
+        daemon_state.queue_head = job;
+    }
+    daemon_state.queue_tail = job;
+    pthread_cond_signal(&daemon_state.queue_ready);
+    pthread_mutex_unlock(&daemon_state.queue_lock);
+}
+
+/**
+ * Tells the writer no more requests will come and drops the reader's reference
+ */
+void daemon_end_reading(struct DaemonConnection* conn) {
+    pthread_mutex_lock(&conn->lock);
+    conn->reading_done = true;
+    pthread_cond_signal(&conn->reply_ready);
+    pthread_mutex_unlock(&conn->lock);
+
+    daemon_release_connection(conn);
+}
+
+/**
+ * Reads request lines from one client until QUIT or end of stream
+ */
+void* daemon_reader(void* arg) {
+    struct DaemonConnection* conn = (struct DaemonConnection*)arg;
+    char buffer[4 * DAEMON_MAX_LINE];
+    size_t used = 0;
+    bool quit = false;
+
+    while (!quit) {
+        ssize_t got = read(conn->fd, buffer + used, sizeof(buffer) - used);
+        if (got < 0 && errno == EINTR) continue;
+        if (got <= 0) break;
+        used += (size_t)got;
+
+        size_t start = 0;
+        for (size_t i = 0; i < used && !quit; i++) {
+            if (buffer[i] != '\n') continue;
+
+            buffer[i] = '\0';
+            if (i > start && buffer[i - 1] == '\r') buffer[i - 1] = '\0';
+            const char* line = buffer + start;
+            start = i + 1;
+
+            if (strlen(line) >= DAEMON_MAX_LINE) {
+                daemon_submit(conn, "");
+            } else if (strcmp(line, "QUIT") == 0) {
+                quit = true;
+            } else if (line[0] != '\0') {
+                daemon_submit(conn, line);
+            }
+        }
+
+        memmove(buffer, buffer + start, used - start);
+        used -= start;
+        if (used == sizeof(buffer)) {
+            // Line too long to ever complete
+            break;
+        }
+    }
+
+    daemon_end_reading(conn);
+    return NULL;
+}
+
+/**
+ * Runs the daemon until SIGINT or SIGTERM
+ */
+int run_daemon(const char* socket_path, int num_workers) {
+    struct sockaddr_un addr;
+    if (strlen(socket_path) >= sizeof(addr.sun_path)) {
+        printf("Socket path too long: %s\n", socket_path);
+        return 1;
+    }
+
+    // Load every table once; all requests share them read-only
+    for (int n = 2; n <= MAX_SIZE; n++) {
+        int goal[MAX_SIZE][MAX_SIZE];
+        default_goal_state(goal, n);
+        build_heuristic_tables(&daemon_state.tables[n], goal, n);
+        if (daemon_state.perimeter_radius >= 0) {
+            // One radius serves every size, so larger boards keep only the layers that fit
+            struct Perimeter* perimeter = &daemon_state.perimeters[n];
+            int radius = daemon_state.perimeter_radius;
+            if (!build_capped_perimeter(perimeter, daemon_state.tables[n].goal, n, radius)) {
+                printf("Cannot build a %dx%d perimeter of radius %d: out of memory\n", n, n, radius);
+                for (int built = 2; built < n; built++) {
+                    free_perimeter(&daemon_state.perimeters[built]);
+                }
+                return 1;
+            }
+            printf("Perimeter for %dx%d: %zu states within %d moves\n", n, n, perimeter->count,
+                   perimeter->radius);
+            if (perimeter->radius < radius) {
+                printf("Perimeter for %dx%d capped at radius %d to stay within %u states\n", n, n,
+                       perimeter->radius, PERIMETER_MAX_STATES);
+            }
+        }
+    }
+
+    pthread_mutex_init(&daemon_state.queue_lock, NULL);
+    pthread_cond_init(&daemon_state.queue_ready, NULL);
+    pthread_mutex_init(&daemon_state.stats_lock, NULL);
+
+    daemon_listen_fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (daemon_listen_fd < 0) {
+        printf("Cannot create socket: %s\n", strerror(errno));
+        return 1;
+    }
+    memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    strcpy(addr.sun_path, socket_path);
+    unlink(socket_path);
+    if (bind(daemon_listen_fd, (struct sockaddr*)&addr, sizeof(addr)) != 0 ||
+        listen(daemon_listen_fd, 64) != 0) {
+        printf("Cannot listen on %s: %s\n", socket_path, strerror(errno));
+        close(daemon_listen_fd);
+        return 1;
+    }
+
+    struct sigaction action;
+    memset(&action, 0, sizeof(action));
+    action.sa_handler = daemon_handle_signal;
+    sigaction(SIGINT, &action, NULL);
+    sigaction(SIGTERM, &action, NULL);
+    signal(SIGPIPE, SIG_IGN);
+
+    pthread_t* workers = (pthread_t*)malloc(num_workers * sizeof(pthread_t));
+    if (!workers) {
+        printf("Memory allocation failed!\n");
+        return 1;
+    }
+    for (int i = 0; i < num_workers; i++) {
+        pthread_create(&workers[i], NULL, daemon_worker, NULL);
+    }
+
+    printf("Daemon listening on %s with %d workers\n", socket_path, num_workers);
+    fflush(stdout);
+
+    while (!daemon_stop_requested) {
+        int fd = accept(daemon_listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno == EINTR || errno == ECONNABORTED) continue;
+            break;
+        }
+
+        struct DaemonConnection* conn = (struct DaemonConnection*)calloc(1, sizeof(struct DaemonConnection));
+        if (!conn) {
+            close(fd);
+            continue;
+        }
+        conn->fd = fd;
+        conn->refs = 1;
+        pthread_mutex_init(&conn->lock, NULL);
+        pthread_cond_init(&conn->reply_ready, NULL);
+        pthread_cond_init(&conn->slot_free, NULL);
+
+        // The writer cannot finish before reading is done, so the second
+        // reference can be taken after starting it
+        pthread_t reader, writer;
+        if (pthread_create(&writer, NULL, daemon_writer, conn) != 0) {
+            daemon_release_connection(conn);
+            continue;
+        }
+        pthread_detach(writer);
+        conn->refs = 2;
+        if (pthread_create(&reader, NULL, daemon_reader, conn) != 0) {
+            daemon_end_reading(conn);
+            continue;
+        }
+        pthread_detach(reader);
+    }
+
+    // Finish queued work, then stop the pool
+    pthread_mutex_lock(&daemon_state.queue_lock);
+    daemon_state.stopping = true;
+    pthread_cond_broadcast(&daemon_state.queue_ready);
+    pthread_mutex_unlock(&daemon_state.queue_lock);
+    for (int i = 0; i < num_workers; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    free(workers);
+
+    close(daemon_listen_fd);
+    unlink(socket_path);
+    for (int n = 2; n <= MAX_SIZE && daemon_state.perimeter_radius >= 0; n++) {
+        free_perimeter(&daemon_state.perimeters[n]);
+    }
+    printf("Daemon stopped after %ld requests\n", daemon_state.requests);
+    return 0;
+}
+
+/**
+ * Command line entry: npuzzle --daemon SOCKET [--workers K] [--max-nodes N] [--perimeter R]
+ */
+int run_daemon_command(int argc, char* argv[]) {
+    const char* socket_path = NULL;
+    int num_workers = DAEMON_DEFAULT_WORKERS;
+    daemon_state.options.max_nodes = DAEMON_DEFAULT_MAX_NODES;
+    daemon_state.options.lazy_heuristic = true;
+    daemon_state.perimeter_radius = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--daemon") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (strcmp(argv[i], "--workers") == 0 && i + 1 < argc) {
+            num_workers = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+            daemon_state.options.max_nodes = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--perimeter") == 0 && i + 1 < argc) {
+            daemon_state.perimeter_radius = atoi(argv[++i]);
+        } else {
+            printf("Unknown daemon option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (!socket_path || num_workers < 1 || daemon_state.perimeter_radius < -1 ||
+        daemon_state.perimeter_radius > MAX_PERIMETER_RADIUS) {
+        printf("Usage: npuzzle --daemon SOCKET [--workers K] [--max-nodes N] [--perimeter R]\n");
+        return 1;
+    }
+
+    return run_daemon(socket_path, num_workers);
+}
@@ -2,46 +2,64 @@
 
 /**
  * Prints the solution path from initial state to goal state
+ * The path is printed as a move string; boards for every step are opt-in
  */
-void print_solution_path(struct TreeNode* goal_node) {
+void print_solution_path(struct TreeNode* goal_node, int n, bool show_boards) {
     if (!goal_node) {
         printf("No solution path available.\n");
         return;
     }
-    
-    // Create array to store path nodes
-    struct TreeNode* path[1000];
-    int path_length = 0;
-    
-    // Traverse from goal to root to build path
+
+    int length = goal_node->depth;
+    char* moves = tree_solution_moves(goal_node);
+    if (!moves) {
+        printf("Memory allocation failed!\n");
+        return;
+    }
+
+    printf("\n=== SOLUTION PATH ===\n");
+    printf("Number of moves: %d\n", length);
+    printf("Moves: %s\n", length > 0 ? moves : "(none)");
+    if (length > 1) {
+        printf("Run-length: ");
+        print_moves(moves, length, MOVES_RLE);
+        printf("\n");
+    }
+    printf("\n");
+    free(moves);
+
+    if (!show_boards) return;
+
+    // Collect the path root first; it holds depth + 1 nodes
+    struct TreeNode** path = (struct TreeNode**)malloc((length + 1) * sizeof(struct TreeNode*));
+    if (!path) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
     struct TreeNode* current = goal_node;
-    while (current) {
-        path[path_length] = current;
-        path_length++;
+    for (int i = length; i >= 0 && current; i--) {
+        path[i] = current;
         current = current->parent;
     }
-    
-    printf("\n=== SOLUTION PATH ===\n");
-    printf("Number of moves: %d\n\n", path_length - 1);
-    
-    // Print path from root to goal
-    for (int i = path_length - 1; i >= 0; i--) {
-        if (i == path_length - 1) {
-            printf("Initial State (Step %d):\n", path_length - 1 - i);
-        } else if (i == 0) {
-            printf("Goal State (Step %d):\n", path_length - 1 - i);
+
+    for (int i = 0; i <= length; i++) {
+        if (i == 0) {
+            printf("Initial State (Step %d):\n", i);
+        } else if (i == length) {
+            printf("Goal State (Step %d):\n", i);
         } else {
-            printf("Step %d:\n", path_length - 1 - i);
+            printf("Step %d:\n", i);
         }
-        
-        print_puzzle(path[i]->puzzle, 3); // Assuming 3x3 for display
+
+        print_puzzle(path[i]->puzzle, n);
         printf("g=%d, h=%d, f=%d\n", path[i]->g, path[i]->h, path[i]->f);
-        
-        if (i > 0) {
+
+        if (i < length) {
             printf("   ↓\n");
         }
         printf("\n");
     }
+    free(path);
 }
 
 /**
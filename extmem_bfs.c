@@ -0,0 +1,596 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <dirent.h>
+#include <errno.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "npuzzle.h"
+
+#define BFS_STREAM_CHUNK 4096
+#define BFS_MAX_LAYERS 256
+#define BFS_DEFAULT_RUN_STATES (1u << 22)
+#define BFS_PATH_LEN 1024
+#define BFS_MERGE_FAN_IN 64
+
+/*
+ * Disk-backed breadth-first search with delayed duplicate detection.
+ *
+ * Every BFS layer lives in its own file as a sorted array of unique packed
+ * states. Layer d+1 is built in two passes:
+ *   1. Expand layer d, buffering successors in RAM; each full buffer is
+ *      sorted, deduplicated and written out as a run file.
+ *   2. Merge all runs together with layers d and d-1. A state is kept only
+ *      if it is not present in either previous layer (its other neighbours
+ *      can only live there), so the result is the new layer. With more than
+ *      BFS_MERGE_FAN_IN runs, groups of runs are first merged into longer
+ *      runs, so the number of open files stays bounded.
+ * Layers and the progress file are replaced atomically via rename(), so an
+ * interrupted sweep resumes from the last completed layer.
+ */
+
+// Buffered sequential reader over a file of sorted packed states
+struct StateStream {
+    FILE* fp;
+    PackedState* buf;
+    size_t len;
+    size_t pos;
+    bool done;
+};
+
+// Progress of a sweep, persisted in <work_dir>/bfs.state
+struct BfsProgress {
+    int n;
+    PackedState goal;
+    int depth;                                 // Deepest completed layer
+    unsigned long long counts[BFS_MAX_LAYERS]; // States per layer
+};
+
+/**
+ * Builds the path of a file inside the work directory
+ */
+void bfs_path(char* out, const char* dir, const char* name, int a, int b) {
+    char file[64];
+    snprintf(file, sizeof(file), name, a, b);
+    snprintf(out, BFS_PATH_LEN, "%s/%s", dir, file);
+}
+
+/**
+ * Opens a state stream; a missing file behaves as an empty stream
+ */
+bool stream_open(struct StateStream* stream, const char* path) {
+    stream->buf = (PackedState*)malloc(BFS_STREAM_CHUNK * sizeof(PackedState));
+    if (!stream->buf) {
+        printf("Memory allocation failed!\n");
+        exit(1);
+    }
+    stream->fp = fopen(path, "rb");
+    stream->len = 0;
+    stream->pos = 0;
+    stream->done = (stream->fp == NULL);
+    return stream->fp != NULL;
+}
+
+/**
+ * Returns the current state of a stream without consuming it
+ */
+bool stream_peek(struct StateStream* stream, PackedState* state) {
+    if (stream->done) return false;
+
+    if (stream->pos == stream->len) {
+        stream->len = fread(stream->buf, sizeof(PackedState), BFS_STREAM_CHUNK, stream->fp);
+        stream->pos = 0;
+        if (stream->len == 0) {
+            stream->done = true;
+            return false;
+        }
+    }
+
+    *state = stream->buf[stream->pos];
+    return true;
+}
+
+void stream_close(struct StateStream* stream) {
+    if (stream->fp) fclose(stream->fp);
+    free(stream->buf);
+    stream->fp = NULL;
+    stream->buf = NULL;
+}
+
+/**
+ * Advances a sorted stream past every state smaller than the key and
+ * reports whether the key itself is present
+ */
+bool stream_contains(struct StateStream* stream, PackedState key) {
+    PackedState state;
+    while (stream_peek(stream, &state) && state < key) {
+        stream->pos++;
+    }
+    return stream_peek(stream, &state) && state == key;
+}
+
+int compare_packed_states(const void* a, const void* b) {
+    PackedState x = *(const PackedState*)a;
+    PackedState y = *(const PackedState*)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * Sorts and deduplicates a buffer in place, returning the new length
+ */
+size_t sort_unique_states(PackedState* states, size_t count) {
+    if (count == 0) return 0;
+
+    qsort(states, count, sizeof(PackedState), compare_packed_states);
+
+    size_t unique = 1;
+    for (size_t i = 1; i < count; i++) {
+        if (states[i] != states[unique - 1]) {
+            states[unique++] = states[i];
+        }
+    }
+    return unique;
+}
+
+/**
+ * Writes a buffer of states to a file, reporting I/O errors
+ */
+bool write_states(const char* path, const PackedState* states, size_t count) {
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        printf("Cannot create %s: %s\n", path, strerror(errno));
+        return false;
+    }
+
+    bool ok = fwrite(states, sizeof(PackedState), count, fp) == count;
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok) {
+        printf("Write to %s failed: %s\n", path, strerror(errno));
+    }
+    return ok;
+}
+
+/**
+ * Saves sweep progress atomically
+ */
+bool save_progress(const char* dir, const struct BfsProgress* progress) {
+    char path[BFS_PATH_LEN], tmp[BFS_PATH_LEN];
+    bfs_path(path, dir, "bfs.state", 0, 0);
+    bfs_path(tmp, dir, "bfs.state.tmp", 0, 0);
+
+    FILE* fp = fopen(tmp, "w");
+    if (!fp) {
+        printf("Cannot create %s: %s\n", tmp, strerror(errno));
+        return false;
+    }
+
+    fprintf(fp, "n %d\n", progress->n);
+    fprintf(fp, "goal %016llx\n", (unsigned long long)progress->goal);
+    for (int d = 0; d <= progress->depth; d++) {
+        fprintf(fp, "layer %d %llu\n", d, progress->counts[d]);
+    }
+
+    if (fclose(fp) != 0 || rename(tmp, path) != 0) {
+        printf("Cannot save progress to %s: %s\n", path, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Loads sweep progress; returns false if no previous sweep exists
+ */
+bool load_progress(const char* dir, struct BfsProgress* progress) {
+    char path[BFS_PATH_LEN];
+    bfs_path(path, dir, "bfs.state", 0, 0);
+
+    FILE* fp = fopen(path, "r");
+    if (!fp) return false;
+
+    unsigned long long goal = 0;
+    progress->depth = -1;
+    if (fscanf(fp, "n %d\n", &progress->n) != 1 || fscanf(fp, "goal %llx\n", &goal) != 1) {
+        fclose(fp);
+        return false;
+    }
+    progress->goal = (PackedState)goal;
+
+    int d;
+    unsigned long long count;
+    while (fscanf(fp, "layer %d %llu\n", &d, &count) == 2 && d == progress->depth + 1 &&
+           d < BFS_MAX_LAYERS) {
+        progress->counts[d] = count;
+        progress->depth = d;
+    }
+
+    fclose(fp);
+    return progress->depth >= 0;
+}
+
+/**
+ * Pass 1: expands a layer into sorted, deduplicated run files
+ * Returns the number of runs written, or -1 on error
+ */
+int expand_layer_to_runs(const struct ExtBfsOptions* options, int n, int depth,
+                         PackedState* buffer) {
+    char path[BFS_PATH_LEN];
+    struct StateStream layer;
+    bfs_path(path, options->work_dir, "layer_%04d.bin", depth, 0);
+    if (!stream_open(&layer, path)) {
+        printf("Missing layer file %s\n", path);
+        stream_close(&layer);
+        return -1;
+    }
+
+    int runs = 0;
+    size_t count = 0;
+    PackedState state;
+
+    while (true) {
+        bool more = stream_peek(&layer, &state);
+
+        // Flush when the buffer cannot hold another full set of successors
+        if (count + NUM_MOVES > options->run_states || (!more && count > 0)) {
+            count = sort_unique_states(buffer, count);
+            bfs_path(path, options->work_dir, "run_%04d_%04d.bin", depth + 1, runs);
+            if (!write_states(path, buffer, count)) {
+                stream_close(&layer);
+                return -1;
+            }
+            runs++;
+            count = 0;
+        }
+        if (!more) break;
+        layer.pos++;
+
+        int blank = packed_blank_cell(state, n);
+        for (int dir = 0; dir < NUM_MOVES; dir++) {
+            PackedState next;
+            int next_blank;
+            if (packed_move(state, blank, dir, n, &next, &next_blank)) {
+                buffer[count++] = next;
+            }
+        }
+    }
+
+    stream_close(&layer);
+    return runs;
+}
+
+/**
+ * Restores the min-heap property of the run heap below index i
+ */
+void sift_down_runs(int* heap, const PackedState* keys, int size, int i) {
+    while (true) {
+        int smallest = i;
+        int left = 2 * i + 1, right = 2 * i + 2;
+        if (left < size && keys[heap[left]] < keys[heap[smallest]]) smallest = left;
+        if (right < size && keys[heap[right]] < keys[heap[smallest]]) smallest = right;
+        if (smallest == i) return;
+
+        int tmp = heap[i];
+        heap[i] = heap[smallest];
+        heap[smallest] = tmp;
+        i = smallest;
+    }
+}
+
+/**
+ * Opens runs first..first+count-1 of a layer; a run that cannot be opened is
+ * an error, since treating it as empty would silently lose states
+ */
+bool open_runs(const char* dir, int layer, int first, int count, struct StateStream* runs) {
+    char path[BFS_PATH_LEN];
+    for (int r = 0; r < count; r++) {
+        bfs_path(path, dir, "run_%04d_%04d.bin", layer, first + r);
+        if (!stream_open(&runs[r], path)) {
+            printf("Cannot open run %s: %s\n", path, strerror(errno));
+            for (int i = 0; i <= r; i++) {
+                stream_close(&runs[i]);
+            }
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Merges at most BFS_MERGE_FAN_IN sorted runs into out, dropping duplicates
+ * and, when the layer streams are given, states present in either of them
+ * Returns the number of states written, or -1 on error
+ */
+long long merge_streams(struct StateStream* runs, int num_runs, struct StateStream* current,
+                        struct StateStream* previous, FILE* out) {
+    int heap[BFS_MERGE_FAN_IN];
+    PackedState keys[BFS_MERGE_FAN_IN];
+    PackedState* out_buf = (PackedState*)malloc(BFS_STREAM_CHUNK * sizeof(PackedState));
+    if (!out_buf) {
+        printf("Memory allocation failed!\n");
+        return -1;
+    }
+
+    // Seed the heap with the head of every run
+    int heap_size = 0;
+    for (int r = 0; r < num_runs; r++) {
+        if (stream_peek(&runs[r], &keys[r])) {
+            heap[heap_size++] = r;
+        }
+    }
+    for (int i = heap_size / 2 - 1; i >= 0; i--) {
+        sift_down_runs(heap, keys, heap_size, i);
+    }
+
+    size_t out_len = 0;
+    long long written = 0;
+    bool have_last = false, ok = true;
+    PackedState last = 0;
+
+    while (heap_size > 0) {
+        int r = heap[0];
+        PackedState state = keys[r];
+
+        // Advance the run that supplied the minimum
+        runs[r].pos++;
+        if (stream_peek(&runs[r], &keys[r])) {
+            sift_down_runs(heap, keys, heap_size, 0);
+        } else {
+            heap[0] = heap[--heap_size];
+            sift_down_runs(heap, keys, heap_size, 0);
+        }
+
+        if (have_last && state == last) continue;
+        have_last = true;
+        last = state;
+
+        if (current && (stream_contains(current, state) || stream_contains(previous, state))) {
+            continue;
+        }
+
+        out_buf[out_len++] = state;
+        written++;
+        if (out_len == BFS_STREAM_CHUNK) {
+            ok = ok && fwrite(out_buf, sizeof(PackedState), out_len, out) == out_len;
+            out_len = 0;
+        }
+    }
+    ok = ok && fwrite(out_buf, sizeof(PackedState), out_len, out) == out_len;
+
+    free(out_buf);
+    return ok ? written : -1;
+}
+
+/**
+ * Merges a group of runs into the single run target and removes the inputs
+ */
+bool merge_run_group(const char* dir, int layer, int first, int count, int target) {
+    char path[BFS_PATH_LEN];
+    struct StateStream runs[BFS_MERGE_FAN_IN];
+    if (!open_runs(dir, layer, first, count, runs)) return false;
+
+    bfs_path(path, dir, "run_%04d_%04d.bin", layer, target);
+    FILE* out = fopen(path, "wb");
+    bool ok = out != NULL && merge_streams(runs, count, NULL, NULL, out) >= 0;
+    if (out) ok = (fclose(out) == 0) && ok;
+    if (!ok) {
+        printf("Cannot write run %s: %s\n", path, strerror(errno));
+    }
+
+    for (int r = 0; r < count; r++) {
+        stream_close(&runs[r]);
+        bfs_path(path, dir, "run_%04d_%04d.bin", layer, first + r);
+        if (ok) unlink(path);
+    }
+    return ok;
+}
+
+/**
+ * Pass 2: merges the run files, dropping states present in the two
+ * previous layers, and writes the next layer atomically
+ * Returns the size of the new layer, or -1 on error
+ */
+long long merge_runs_into_layer(const struct ExtBfsOptions* options, int depth, int num_runs) {
+    const char* dir = options->work_dir;
+    char path[BFS_PATH_LEN], tmp[BFS_PATH_LEN];
+
+    // Keep the number of open files bounded: while there are too many runs,
+    // merge groups of them into longer runs numbered after the current ones
+    int first = 0;
+    while (num_runs > BFS_MERGE_FAN_IN) {
+        int target = first + num_runs;
+        int merged = 0;
+        for (int start = 0; start < num_runs; start += BFS_MERGE_FAN_IN) {
+            int count = num_runs - start < BFS_MERGE_FAN_IN ? num_runs - start : BFS_MERGE_FAN_IN;
+            if (!merge_run_group(dir, depth + 1, first + start, count, target + merged)) return -1;
+            merged++;
+        }
+        first = target;
+        num_runs = merged;
+    }
+
+    struct StateStream runs[BFS_MERGE_FAN_IN];
+    if (!open_runs(dir, depth + 1, first, num_runs, runs)) return -1;
+
+    // Previous layers used for duplicate elimination
+    struct StateStream current, previous;
+    bfs_path(path, dir, "layer_%04d.bin", depth, 0);
+    stream_open(&current, path);
+    bfs_path(path, dir, "layer_%04d.bin", depth - 1, 0);
+    stream_open(&previous, path);
+
+    bfs_path(path, dir, "layer_%04d.bin", depth + 1, 0);
+    bfs_path(tmp, dir, "layer_%04d.tmp", depth + 1, 0);
+    long long written = -1;
+    FILE* out = fopen(tmp, "wb");
+    if (out) {
+        written = merge_streams(runs, num_runs, &current, &previous, out);
+        bool ok = (fclose(out) == 0) && written >= 0 && rename(tmp, path) == 0;
+        if (!ok) written = -1;
+    }
+    if (written < 0) {
+        printf("Cannot write layer %s: %s\n", path, strerror(errno));
+    }
+
+    for (int r = 0; r < num_runs; r++) {
+        stream_close(&runs[r]);
+    }
+    stream_close(&current);
+    stream_close(&previous);
+    return written;
+}
+
+/**
+ * Removes leftover run files for a layer (also cleans up after a crash,
+ * including the gaps a partial multi-pass merge leaves in the numbering)
+ */
+void remove_runs(const char* dir, int layer) {
+    char path[BFS_PATH_LEN], prefix[32];
+    snprintf(prefix, sizeof(prefix), "run_%04d_", layer);
+
+    DIR* listing = opendir(dir);
+    if (!listing) return;
+    struct dirent* entry;
+    while ((entry = readdir(listing)) != NULL) {
+        if (strncmp(entry->d_name, prefix, strlen(prefix)) != 0) continue;
+        snprintf(path, sizeof(path), "%s/%s", dir, entry->d_name);
+        unlink(path);
+    }
+    closedir(listing);
+}
+
+/**
+ * Prints the depth histogram of a sweep
+ */
+void print_bfs_histogram(const struct BfsProgress* progress) {
+    unsigned long long total = 0;
+
+    printf("\n=== BFS DEPTH HISTOGRAM ===\n");
+    printf("Depth  States\n");
+    for (int d = 0; d <= progress->depth; d++) {
+        if (progress->counts[d] == 0) continue;
+        printf("%5d  %llu\n", d, progress->counts[d]);
+        total += progress->counts[d];
+    }
+    printf("Total states: %llu\n", total);
+}
+
+/**
+ * Runs (or resumes) a breadth-first sweep of the whole state space
+ * reachable from the goal state, layer by layer on disk
+ */
+int external_bfs(int goal[MAX_SIZE][MAX_SIZE], int n, const struct ExtBfsOptions* options) {
+    char path[BFS_PATH_LEN];
+    struct BfsProgress progress;
+    PackedState goal_state = pack_state(goal, n);
+
+    if (mkdir(options->work_dir, 0755) != 0 && errno != EEXIST) {
+        printf("Cannot create work directory %s: %s\n", options->work_dir, strerror(errno));
+        return 1;
+    }
+
+    if (load_progress(options->work_dir, &progress)) {
+        if (progress.n != n || progress.goal != goal_state) {
+            printf("Work directory %s holds a sweep for a different puzzle.\n", options->work_dir);
+            return 1;
+        }
+        printf("Resuming sweep after layer %d\n", progress.depth);
+    } else {
+        // Layer 0 is the goal state itself
+        progress.n = n;
+        progress.goal = goal_state;
+        progress.depth = 0;
+        progress.counts[0] = 1;
+        bfs_path(path, options->work_dir, "layer_%04d.bin", 0, 0);
+        if (!write_states(path, &goal_state, 1) || !save_progress(options->work_dir, &progress)) {
+            return 1;
+        }
+    }
+
+    PackedState* buffer = (PackedState*)malloc(options->run_states * sizeof(PackedState));
+    if (!buffer) {
+        printf("Memory allocation failed!\n");
+        return 1;
+    }
+
+    while (progress.counts[progress.depth] > 0 && progress.depth + 1 < BFS_MAX_LAYERS &&
+           (options->max_depth < 0 || progress.depth < options->max_depth)) {
+        int depth = progress.depth;
+
+        remove_runs(options->work_dir, depth + 1);
+        int num_runs = expand_layer_to_runs(options, n, depth, buffer);
+        if (num_runs < 0) break;
+
+        long long count = merge_runs_into_layer(options, depth, num_runs);
+        if (count < 0) break;
+        remove_runs(options->work_dir, depth + 1);
+
+        progress.depth = depth + 1;
+        progress.counts[depth + 1] = (unsigned long long)count;
+        if (!save_progress(options->work_dir, &progress)) break;
+
+        printf("Layer %d: %lld states (%d runs)\n", depth + 1, count, num_runs);
+        fflush(stdout);
+
+        // Layer d-1 is no longer needed once d+1 exists
+        if (!options->keep_layers && depth >= 1) {
+            bfs_path(path, options->work_dir, "layer_%04d.bin", depth - 1, 0);
+            unlink(path);
+        }
+    }
+
+    free(buffer);
+    print_bfs_histogram(&progress);
+
+    bool complete = progress.counts[progress.depth] == 0 ||
+                    (options->max_depth >= 0 && progress.depth >= options->max_depth);
+    return complete ? 0 : 1;
+}
+
+/**
+ * Command line entry: npuzzle --bfs DIR [--size N] [--run-states K]
+ *                                       [--max-depth D] [--keep-layers]
+ */
+int run_external_bfs_command(int argc, char* argv[]) {
+    struct ExtBfsOptions options;
+    int n = 3;
+
+    options.work_dir = NULL;
+    options.run_states = BFS_DEFAULT_RUN_STATES;
+    options.max_depth = -1;
+    options.keep_layers = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--bfs") == 0 && i + 1 < argc) {
+            options.work_dir = argv[++i];
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            n = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--run-states") == 0 && i + 1 < argc) {
+            options.run_states = (size_t)strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--max-depth") == 0 && i + 1 < argc) {
+            options.max_depth = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--keep-layers") == 0) {
+            options.keep_layers = true;
+        } else {
+            printf("Unknown BFS option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (!options.work_dir || n < 2 || n > MAX_SIZE) {
+        printf("Usage: npuzzle --bfs DIR [--size 2-%d] [--run-states K] [--max-depth D] [--keep-layers]\n",
+               MAX_SIZE);
+        return 1;
+    }
+    if (options.run_states < NUM_MOVES) {
+        options.run_states = NUM_MOVES;
+    }
+
+    int goal[MAX_SIZE][MAX_SIZE];
+    default_goal_state(goal, n);
+
+    printf("=== External-Memory BFS ===\n");
+    printf("Puzzle size: %dx%d\n", n, n);
+    printf("Work directory: %s\n", options.work_dir);
+    printf("Goal State:\n");
+    print_puzzle(goal, n);
+
+    return external_bfs(goal, n, &options);
+}
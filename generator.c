@@ -0,0 +1,190 @@
+#include "npuzzle.h"
+
+#define GENERATOR_BUFFER 4096
+#define GENERATOR_MAX_EXACT_ATTEMPTS 100000
+
+/**
+ * xorshift64* step; the state must never be zero
+ */
+uint64_t next_random(uint64_t* rng) {
+    *rng ^= *rng >> 12;
+    *rng ^= *rng << 25;
+    *rng ^= *rng >> 27;
+    return *rng * 0x2545f4914f6cdd1dULL;
+}
+
+/**
+ * Uniform integer in [0, bound) by rejection sampling
+ */
+int random_below(uint64_t* rng, int bound) {
+    uint64_t limit = UINT64_MAX - UINT64_MAX % (uint64_t)bound;
+    uint64_t value;
+    do {
+        value = next_random(rng);
+    } while (value >= limit);
+    return (int)(value % (uint64_t)bound);
+}
+
+/**
+ * Draws a board uniformly from the states that can reach the goal
+ */
+PackedState random_solvable_state(int goal[MAX_SIZE][MAX_SIZE], int n, uint64_t* rng) {
+    int tiles[MAX_SIZE * MAX_SIZE];
+    int puzzle[MAX_SIZE][MAX_SIZE];
+
+    // Fisher-Yates shuffle of all tiles, blank included
+    for (int i = 0; i < n * n; i++) tiles[i] = i;
+    for (int i = n * n - 1; i > 0; i--) {
+        int j = random_below(rng, i + 1);
+        int tmp = tiles[i];
+        tiles[i] = tiles[j];
+        tiles[j] = tmp;
+    }
+    for (int cell = 0; cell < n * n; cell++) {
+        puzzle[cell / n][cell % n] = tiles[cell];
+    }
+
+    // Exactly half the permutations are solvable; swapping two tiles maps
+    // the unsolvable half onto the solvable half one-to-one
+    if (!is_solvable(puzzle, goal, n)) {
+        int a = 0, b = 1;
+        if (tiles[a] == 0) a = 2;
+        if (tiles[b] == 0) b = 2;
+        int tmp = puzzle[a / n][a % n];
+        puzzle[a / n][a % n] = puzzle[b / n][b % n];
+        puzzle[b / n][b % n] = tmp;
+    }
+
+    return pack_state(puzzle, n);
+}
+
+/**
+ * Random walk of the blank from the goal that never undoes its last move
+ */
+PackedState random_walk_state(PackedState goal, int n, int depth, uint64_t* rng) {
+    static const int reverse[NUM_MOVES] = {1, 0, 3, 2};
+    PackedState state = goal;
+    int blank = packed_blank_cell(goal, n);
+    int last = -1;
+
+    for (int step = 0; step < depth; step++) {
+        PackedState next;
+        int next_blank, dir;
+        do {
+            dir = random_below(rng, NUM_MOVES);
+        } while ((last >= 0 && dir == reverse[last]) || !packed_move(state, blank, dir, n, &next, &next_blank));
+        state = next;
+        blank = next_blank;
+        last = dir;
+    }
+
+    return state;
+}
+
+/**
+ * Command line entry: npuzzle --generate FILE --count N [--size N]
+ *                                         [--walk DEPTH [--exact]] [--seed S]
+ */
+int run_generate_command(int argc, char* argv[]) {
+    const char* path = NULL;
+    unsigned long long count = 0, seed = 1;
+    int n = 3, walk_depth = 0;
+    bool exact = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--generate") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (strcmp(argv[i], "--count") == 0 && i + 1 < argc) {
+            count = strtoull(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc) {
+            n = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--walk") == 0 && i + 1 < argc) {
+            walk_depth = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--exact") == 0) {
+            exact = true;
+        } else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc) {
+            seed = strtoull(argv[++i], NULL, 10);
+        } else {
+            printf("Unknown generator option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    if (!path || count == 0 || n < 2 || n > MAX_SIZE || walk_depth < 0 || (exact && walk_depth == 0)) {
+        printf("Usage: npuzzle --generate FILE --count N [--size 2-%d] [--walk DEPTH [--exact]] [--seed S]\n",
+               MAX_SIZE);
+        return 1;
+    }
+
+    int goal[MAX_SIZE][MAX_SIZE];
+    default_goal_state(goal, n);
+    struct HeuristicTables tables;
+    build_heuristic_tables(&tables, goal, n);
+
+    struct CorpusHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, CORPUS_MAGIC, sizeof(header.magic));
+    header.version = CORPUS_VERSION;
+    header.header_size = sizeof(header);
+    header.n = (uint32_t)n;
+    header.record_size = sizeof(PackedState);
+    header.goal = tables.goal;
+    header.seed = seed;
+    header.walk_depth = (uint32_t)walk_depth;
+    header.flags = exact ? CORPUS_EXACT_DEPTH : 0;
+
+    FILE* fp = corpus_create(path, &header);
+    if (!fp) return 1;
+
+    uint64_t rng = seed ? seed : 0x9e3779b97f4a7c15ULL;
+    PackedState buffer[GENERATOR_BUFFER];
+    size_t buffered = 0;
+    uint64_t written = 0, flushed = 0;
+    bool ok = true;
+
+    while (written < count && ok) {
+        PackedState state;
+        if (walk_depth == 0) {
+            state = random_solvable_state(goal, n, &rng);
+        } else if (!exact) {
+            state = random_walk_state(tables.goal, n, walk_depth, &rng);
+        } else {
+            // Keep only walks whose optimal solution is exactly walk_depth long
+            int attempts = 0;
+            while (true) {
+                int puzzle[MAX_SIZE][MAX_SIZE];
+                struct SolveResult result;
+                state = random_walk_state(tables.goal, n, walk_depth, &rng);
+                unpack_state(state, puzzle, n);
+                solve_puzzle(&tables, puzzle, MANHATTAN_DISTANCE, NULL, &result);
+                bool hit = result.status == SOLVE_FOUND && result.length == walk_depth;
+                free_solve_result(&result);
+                if (hit) break;
+                if (++attempts == GENERATOR_MAX_EXACT_ATTEMPTS) {
+                    printf("No instance at exact depth %d after %d attempts.\n", walk_depth, attempts);
+                    ok = false;
+                    break;
+                }
+            }
+            if (!ok) break;
+        }
+
+        buffer[buffered++] = state;
+        written++;
+        if (buffered == GENERATOR_BUFFER || written == count) {
+            ok = fwrite(buffer, sizeof(PackedState), buffered, fp) == buffered;
+            flushed += ok ? buffered : 0;
+            buffered = 0;
+        }
+    }
+
+    // Keep what was generated before an exact-depth search gave up
+    if (buffered > 0 && fwrite(buffer, sizeof(PackedState), buffered, fp) == buffered) {
+        flushed += buffered;
+    }
+
+    ok = corpus_finish(fp, &header, flushed) && ok;
+    printf("Wrote %llu %dx%d instances to %s (%s)\n", (unsigned long long)flushed, n, n, path,
+           walk_depth == 0 ? "uniform random" : exact ? "exact depth" : "random walk");
+    return ok ? 0 : 1;
+}
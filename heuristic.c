@@ -10,6 +10,8 @@ int calculate_heuristic(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_S
             return tiles_out_of_place(puzzle, goal, n);
         case MANHATTAN_DISTANCE:
             return manhattan_distance(puzzle, goal, n);
+        case LINEAR_CONFLICT:
+            return linear_conflict(puzzle, goal, n);
         default:
             return 0;
     }
@@ -70,4 +72,201 @@ int manhattan_distance(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SI
     }
     
     return total_distance;
-}
\ No newline at end of file
+}
+
+/**
+ * Extra moves forced by tiles that sit in their goal line in the wrong order
+ * goal_positions holds the goal offsets along the line of those tiles, in
+ * their current order. All but a longest increasing run of them must leave
+ * the line and come back, which costs two moves each.
+ */
+int line_conflict_penalty(const int* goal_positions, int count) {
+    int longest[MAX_SIZE];
+    int best = 0;
+    
+    for (int i = 0; i < count; i++) {
+        longest[i] = 1;
+        for (int j = 0; j < i; j++) {
+            if (goal_positions[j] < goal_positions[i] && longest[j] + 1 > longest[i]) {
+                longest[i] = longest[j] + 1;
+            }
+        }
+        if (longest[i] > best) best = longest[i];
+    }
+    
+    return 2 * (count - best);
+}
+
+/**
+ * Linear conflict heuristic: Manhattan distance plus line conflict penalties
+ * h(n) = manhattan(n) + sum over rows and columns of line_conflict_penalty
+ */
+int linear_conflict(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE], int n) {
+    int goal_row[MAX_SIZE * MAX_SIZE], goal_col[MAX_SIZE * MAX_SIZE];
+    int positions[MAX_SIZE];
+    int penalty = 0;
+    
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            goal_row[goal[i][j]] = i;
+            goal_col[goal[i][j]] = j;
+        }
+    }
+    
+    for (int line = 0; line < n; line++) {
+        // Tiles in this row that belong to this row
+        int count = 0;
+        for (int j = 0; j < n; j++) {
+            int tile = puzzle[line][j];
+            if (tile != 0 && goal_row[tile] == line) positions[count++] = goal_col[tile];
+        }
+        penalty += line_conflict_penalty(positions, count);
+        
+        // Tiles in this column that belong to this column
+        count = 0;
+        for (int i = 0; i < n; i++) {
+            int tile = puzzle[i][line];
+            if (tile != 0 && goal_col[tile] == line) positions[count++] = goal_row[tile];
+        }
+        penalty += line_conflict_penalty(positions, count);
+    }
+    
+    return manhattan_distance(puzzle, goal, n) + penalty;
+}
+
+/**
+ * Precomputes goal positions and per-cell Manhattan distances for a goal
+ */
+void build_heuristic_tables(struct HeuristicTables* tables, int goal[MAX_SIZE][MAX_SIZE], int n) {
+    tables->n = n;
+    tables->goal = pack_state(goal, n);
+    
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            tables->goal_cell[goal[i][j]] = i * n + j;
+        }
+    }
+    
+    for (int tile = 0; tile < n * n; tile++) {
+        int goal_row = tables->goal_cell[tile] / n;
+        int goal_col = tables->goal_cell[tile] % n;
+        for (int cell = 0; cell < n * n; cell++) {
+            tables->distance[tile][cell] = abs(cell / n - goal_row) + abs(cell % n - goal_col);
+        }
+    }
+    
+    // Operator tables: the tile next to the blank slides into the blank's cell
+    for (int blank = 0; blank < n * n; blank++) {
+        for (int dir = 0; dir < NUM_MOVES; dir++) {
+            int row = blank / n + MOVE_DELTAS[dir][0];
+            int col = blank % n + MOVE_DELTAS[dir][1];
+            for (int tile = 0; tile < n * n; tile++) {
+                if (!is_valid_move(row, col, n) || tile == 0) {
+                    tables->operator_delta_f[TILES_OUT_OF_PLACE][blank][dir][tile] = 0;
+                    tables->operator_delta_f[MANHATTAN_DISTANCE][blank][dir][tile] = 0;
+                    continue;
+                }
+                int from = row * n + col;
+                int goal_cell = tables->goal_cell[tile];
+                tables->operator_delta_f[TILES_OUT_OF_PLACE][blank][dir][tile] =
+                    (signed char)(1 + (goal_cell != blank) - (goal_cell != from));
+                tables->operator_delta_f[MANHATTAN_DISTANCE][blank][dir][tile] =
+                    (signed char)(1 + tables->distance[tile][blank] - tables->distance[tile][from]);
+            }
+        }
+    }
+}
+
+/**
+ * Table-driven heuristic evaluation on a packed state
+ */
+int packed_heuristic(const struct HeuristicTables* tables, PackedState state, HeuristicType type) {
+    int n = tables->n;
+    int h = 0;
+    
+    if (type == LINEAR_CONFLICT) {
+        int positions[MAX_SIZE];
+        for (int line = 0; line < n; line++) {
+            int row_count = 0;
+            for (int j = 0; j < n; j++) {
+                int tile = (int)((state >> (4 * (line * n + j))) & 0xF);
+                int goal_cell = tables->goal_cell[tile];
+                if (tile != 0 && goal_cell / n == line) positions[row_count++] = goal_cell % n;
+            }
+            h += line_conflict_penalty(positions, row_count);
+            
+            int col_count = 0;
+            for (int i = 0; i < n; i++) {
+                int tile = (int)((state >> (4 * (i * n + line))) & 0xF);
+                int goal_cell = tables->goal_cell[tile];
+                if (tile != 0 && goal_cell % n == line) positions[col_count++] = goal_cell / n;
+            }
+            h += line_conflict_penalty(positions, col_count);
+        }
+        type = MANHATTAN_DISTANCE;
+    }
+    
+    for (int cell = 0; cell < n * n; cell++) {
+        int tile = (int)((state >> (4 * cell)) & 0xF);
+        if (tile == 0) continue;
+        
+        switch (type) {
+            case TILES_OUT_OF_PLACE:
+                h += (tables->goal_cell[tile] != cell);
+                break;
+            case MANHATTAN_DISTANCE:
+                h += tables->distance[tile][cell];
+                break;
+            default:
+                break;
+        }
+    }
+    
+    return h;
+}
+
+/**
+ * Returns the display name of a heuristic
+ */
+const char* heuristic_name(HeuristicType type) {
+    switch (type) {
+        case TILES_OUT_OF_PLACE:
+            return "Tiles Out of Place";
+        case MANHATTAN_DISTANCE:
+            return "Manhattan Distance";
+        case LINEAR_CONFLICT:
+            return "Linear Conflict";
+        default:
+            return "Unknown";
+    }
+}
+
+/**
+ * Parses a heuristic name as used on the command line and in protocols
+ */
+bool parse_heuristic_name(const char* name, HeuristicType* type) {
+    if (strcmp(name, "tiles") == 0) {
+        *type = TILES_OUT_OF_PLACE;
+    } else if (strcmp(name, "manhattan") == 0) {
+        *type = MANHATTAN_DISTANCE;
+    } else if (strcmp(name, "linear") == 0) {
+        *type = LINEAR_CONFLICT;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Returns the command line name of a heuristic (inverse of parse_heuristic_name)
+ */
+const char* heuristic_option_name(HeuristicType type) {
+    switch (type) {
+        case TILES_OUT_OF_PLACE:
+            return "tiles";
+        case LINEAR_CONFLICT:
+            return "linear";
+        default:
+            return "manhattan";
+    }
+}
@@ -0,0 +1,265 @@
+#include "npuzzle.h"
+#include "libnpuzzle.h"
+
+/*
+ * Public library wrapper around the solver engine. The context is
+ * read-only during solves; all per-search state lives on the caller's
+ * stack or in memory owned by the solve.
+ */
+
+struct NPuzzleSolver {
+    struct HeuristicTables tables;
+    HeuristicType heuristic_type;
+    SearchAlgorithm algorithm;
+    bool lazy_heuristic;
+    long deadline_ms;
+    long max_nodes;
+    volatile const sig_atomic_t* cancel;
+    NPuzzleProgressFn progress;
+    void* progress_user_data;
+    long progress_interval;
+    char* checkpoint_path;           // Owned copy, or NULL
+    double checkpoint_interval;
+    struct Perimeter perimeter;
+    bool has_perimeter;
+};
+
+// Per-call bridge from engine progress to the public callback
+struct ProgressBridge {
+    NPuzzleProgressFn fn;
+    void* user_data;
+};
+
+NPuzzleSolver* npuzzle_solver_create(int n, const int* goal) {
+    if (n < 2 || n > MAX_SIZE || (goal && !is_permutation_board(goal, n))) {
+        return NULL;
+    }
+
+    NPuzzleSolver* solver = (NPuzzleSolver*)calloc(1, sizeof(NPuzzleSolver));
+    if (!solver) return NULL;
+
+    int goal_grid[MAX_SIZE][MAX_SIZE];
+    if (goal) {
+        for (int cell = 0; cell < n * n; cell++) {
+            goal_grid[cell / n][cell % n] = goal[cell];
+        }
+    } else {
+        default_goal_state(goal_grid, n);
+    }
+
+    build_heuristic_tables(&solver->tables, goal_grid, n);
+    solver->heuristic_type = MANHATTAN_DISTANCE;
+    return solver;
+}
+
+void npuzzle_solver_destroy(NPuzzleSolver* solver) {
+    if (!solver) return;
+    if (solver->has_perimeter) free_perimeter(&solver->perimeter);
+    free(solver->checkpoint_path);
+    free(solver);
+}
+
+void npuzzle_solver_set_heuristic(NPuzzleSolver* solver, NPuzzleHeuristic heuristic) {
+    switch (heuristic) {
+        case NPUZZLE_HEURISTIC_TILES:
+            solver->heuristic_type = TILES_OUT_OF_PLACE;
+            break;
+        case NPUZZLE_HEURISTIC_LINEAR_CONFLICT:
+            solver->heuristic_type = LINEAR_CONFLICT;
+            break;
+        default:
+            solver->heuristic_type = MANHATTAN_DISTANCE;
+            break;
+    }
+}
+
+void npuzzle_solver_set_algorithm(NPuzzleSolver* solver, NPuzzleAlgorithm algorithm) {
+    solver->algorithm = (algorithm == NPUZZLE_ALGORITHM_EPEA) ? SEARCH_EPEA : SEARCH_ASTAR;
+}
+
+void npuzzle_solver_set_lazy_heuristic(NPuzzleSolver* solver, int enabled) {
+    solver->lazy_heuristic = enabled != 0;
+}
+
+void npuzzle_solver_set_deadline_ms(NPuzzleSolver* solver, long milliseconds) {
+    solver->deadline_ms = milliseconds;
+}
+
+void npuzzle_solver_set_node_budget(NPuzzleSolver* solver, long max_nodes) {
+    solver->max_nodes = max_nodes;
+}
+
+void npuzzle_solver_set_cancel_flag(NPuzzleSolver* solver, volatile const sig_atomic_t* flag) {
+    solver->cancel = flag;
+}
+
+void npuzzle_solver_set_progress_callback(NPuzzleSolver* solver, NPuzzleProgressFn fn,
+                                          void* user_data, long interval) {
+    solver->progress = fn;
+    solver->progress_user_data = user_data;
+    solver->progress_interval = interval;
+}
+
+int npuzzle_solver_set_perimeter(NPuzzleSolver* solver, int radius) {
+    if (solver->has_perimeter) {
+        free_perimeter(&solver->perimeter);
+        solver->has_perimeter = false;
+    }
+    if (radius < 0) return 1;
+    if (!build_perimeter(&solver->perimeter, solver->tables.goal, solver->tables.n, radius)) return 0;
+    solver->has_perimeter = true;
+    return 1;
+}
+
+int npuzzle_solver_set_checkpoint(NPuzzleSolver* solver, const char* path, double interval_seconds) {
+    char* copy = NULL;
+    if (path) {
+        size_t length = strlen(path) + 1;
+        copy = (char*)malloc(length);
+        if (!copy) return 0;
+        memcpy(copy, path, length);
+    }
+    free(solver->checkpoint_path);
+    solver->checkpoint_path = copy;
+    solver->checkpoint_interval = interval_seconds;
+    return 1;
+}
+
+static void forward_progress(const struct SolveProgress* progress, void* user_data) {
+    const struct ProgressBridge* bridge = (const struct ProgressBridge*)user_data;
+    NPuzzleProgress public_progress = {progress->nodes_expanded, progress->open_size,
+                                       progress->f, progress->elapsed_seconds};
+    bridge->fn(&public_progress, bridge->user_data);
+}
+
+static NPuzzleStatus map_solve_status(SolveStatus status) {
+    switch (status) {
+        case SOLVE_FOUND:
+            return NPUZZLE_SOLVED;
+        case SOLVE_NODE_LIMIT:
+            return NPUZZLE_NODE_BUDGET;
+        case SOLVE_DEADLINE:
+            return NPUZZLE_DEADLINE;
+        case SOLVE_CANCELLED:
+            return NPUZZLE_CANCELLED;
+        case SOLVE_BAD_CHECKPOINT:
+            return NPUZZLE_BAD_CHECKPOINT;
+        case SOLVE_OUT_OF_MEMORY:
+            return NPUZZLE_OUT_OF_MEMORY;
+        default:
+            return NPUZZLE_NO_SOLUTION;
+    }
+}
+
+/**
+ * Translates the context into engine options for one solve
+ */
+static void fill_solve_options(const NPuzzleSolver* solver, struct ProgressBridge* bridge,
+                               struct SolveOptions* options) {
+    memset(options, 0, sizeof(*options));
+    options->algorithm = solver->algorithm;
+    options->lazy_heuristic = solver->lazy_heuristic;
+    options->max_nodes = solver->max_nodes;
+    options->cancel = solver->cancel;
+    if (solver->deadline_ms > 0) {
+        options->deadline = monotonic_seconds() + solver->deadline_ms / 1000.0;
+    }
+    if (solver->progress && solver->progress_interval > 0) {
+        bridge->fn = solver->progress;
+        bridge->user_data = solver->progress_user_data;
+        options->progress = forward_progress;
+        options->progress_user_data = bridge;
+        options->progress_interval = solver->progress_interval;
+    }
+    options->checkpoint_path = solver->checkpoint_path;
+    options->checkpoint_interval = solver->checkpoint_interval;
+    options->perimeter = solver->has_perimeter ? &solver->perimeter : NULL;
+}
+
+static NPuzzleStatus copy_solve_result(const struct SolveResult* solve, NPuzzleResult* result) {
+    result->status = map_solve_status(solve->status);
+    result->moves = solve->moves;
+    result->length = solve->length;
+    result->stats.nodes_expanded = solve->nodes_expanded;
+    result->stats.nodes_generated = solve->nodes_generated;
+    result->stats.nodes_stored = solve->nodes_stored;
+    result->stats.peak_open = solve->peak_open;
+    result->stats.elapsed_seconds = solve->elapsed_seconds;
+    return result->status;
+}
+
+NPuzzleStatus npuzzle_solve(const NPuzzleSolver* solver, const int* board, NPuzzleResult* result) {
+    int n = solver->tables.n;
+    memset(result, 0, sizeof(*result));
+
+    if (!is_permutation_board(board, n)) {
+        result->status = NPUZZLE_INVALID_INPUT;
+        return result->status;
+    }
+
+    int initial[MAX_SIZE][MAX_SIZE];
+    for (int cell = 0; cell < n * n; cell++) {
+        initial[cell / n][cell % n] = board[cell];
+    }
+
+    struct ProgressBridge bridge;
+    struct SolveOptions options;
+    fill_solve_options(solver, &bridge, &options);
+
+    struct SolveResult solve;
+    solve_puzzle(&solver->tables, initial, solver->heuristic_type, &options, &solve);
+    return copy_solve_result(&solve, result);
+}
+
+NPuzzleStatus npuzzle_resume(const NPuzzleSolver* solver, const char* path, NPuzzleResult* result) {
+    memset(result, 0, sizeof(*result));
+
+    struct ProgressBridge bridge;
+    struct SolveOptions options;
+    fill_solve_options(solver, &bridge, &options);
+    options.resume_path = path;
+
+    struct SolveResult solve;
+    solve_puzzle(&solver->tables, NULL, solver->heuristic_type, &options, &solve);
+    return copy_solve_result(&solve, result);
+}
+
+int npuzzle_verify(const NPuzzleSolver* solver, const int* board, const char* moves) {
+    int n = solver->tables.n;
+    if (!is_permutation_board(board, n) || !moves) return 0;
+
+    int grid[MAX_SIZE][MAX_SIZE];
+    for (int cell = 0; cell < n * n; cell++) {
+        grid[cell / n][cell % n] = board[cell];
+    }
+    return verify_solution(pack_state(grid, n), solver->tables.goal, moves, (int)strlen(moves), n);
+}
+
+void npuzzle_result_free(NPuzzleResult* result) {
+    free(result->moves);
+    result->moves = NULL;
+    result->length = 0;
+}
+
+const char* npuzzle_status_string(NPuzzleStatus status) {
+    switch (status) {
+        case NPUZZLE_SOLVED:
+            return "solved";
+        case NPUZZLE_NO_SOLUTION:
+            return "no_solution";
+        case NPUZZLE_NODE_BUDGET:
+            return "node_budget";
+        case NPUZZLE_DEADLINE:
+            return "deadline";
+        case NPUZZLE_CANCELLED:
+            return "cancelled";
+        case NPUZZLE_INVALID_INPUT:
+            return "invalid_input";
+        case NPUZZLE_BAD_CHECKPOINT:
+            return "bad_checkpoint";
+        case NPUZZLE_OUT_OF_MEMORY:
+            return "out_of_memory";
+        default:
+            return "unknown";
+    }
+}
@@ -0,0 +1,122 @@
+#ifndef LIBNPUZZLE_H
+#define LIBNPUZZLE_H
+
+/*
+ * libnpuzzle - embeddable optimal N-Puzzle solver
+ *
+ * A solver context holds the goal, its precomputed heuristic tables and the
+ * search limits. Configure it once, then call npuzzle_solve() from any
+ * number of threads at the same time: every call allocates its own search
+ * memory and only reads the context. Setters must not run concurrently
+ * with solves on the same context.
+ *
+ * Boards are passed as n*n ints in row-major order with 0 for the blank.
+ * Solutions are strings of blank moves: 'U', 'D', 'L', 'R'.
+ */
+
+#include <signal.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// Marks the public API; the shared library is built with every other symbol hidden
+#if defined(__GNUC__)
+#define NPUZZLE_API __attribute__((visibility("default")))
+#else
+#define NPUZZLE_API
+#endif
+
+typedef struct NPuzzleSolver NPuzzleSolver;
+
+typedef enum {
+    NPUZZLE_HEURISTIC_TILES,         // Tiles out of place
+    NPUZZLE_HEURISTIC_MANHATTAN,     // Manhattan distance
+    NPUZZLE_HEURISTIC_LINEAR_CONFLICT // Manhattan distance plus linear conflicts
+} NPuzzleHeuristic;
+
+typedef enum {
+    NPUZZLE_ALGORITHM_ASTAR,         // Plain A*
+    NPUZZLE_ALGORITHM_EPEA           // Enhanced Partial Expansion A* (stores far fewer nodes)
+} NPuzzleAlgorithm;
+
+typedef enum {
+    NPUZZLE_SOLVED,                  // Optimal solution found
+    NPUZZLE_NO_SOLUTION,             // Search space exhausted
+    NPUZZLE_NODE_BUDGET,             // Node budget exceeded
+    NPUZZLE_DEADLINE,                // Deadline passed
+    NPUZZLE_CANCELLED,               // Cancel flag raised
+    NPUZZLE_INVALID_INPUT,           // Board is not a permutation of 0..n*n-1
+    NPUZZLE_BAD_CHECKPOINT,          // Checkpoint unreadable or taken with other settings
+    NPUZZLE_OUT_OF_MEMORY            // Search memory could not be allocated
+} NPuzzleStatus;
+
+typedef struct {
+    long nodes_expanded;
+    long nodes_generated;
+    long nodes_stored;
+    long peak_open;
+    double elapsed_seconds;
+} NPuzzleStats;
+
+typedef struct {
+    NPuzzleStatus status;
+    char* moves;                     // NUL-terminated move string, NULL unless solved
+    int length;                      // Number of moves
+    NPuzzleStats stats;
+} NPuzzleResult;
+
+typedef struct {
+    long nodes_expanded;
+    long open_size;
+    int f;                           // f value currently being expanded
+    double elapsed_seconds;
+} NPuzzleProgress;
+
+typedef void (*NPuzzleProgressFn)(const NPuzzleProgress* progress, void* user_data);
+
+// Creates a context for n x n boards; goal may be NULL for the snail goal
+// Returns NULL if n or goal is invalid or memory runs out
+NPUZZLE_API NPuzzleSolver* npuzzle_solver_create(int n, const int* goal);
+NPUZZLE_API void npuzzle_solver_destroy(NPuzzleSolver* solver);
+
+NPUZZLE_API void npuzzle_solver_set_heuristic(NPuzzleSolver* solver, NPuzzleHeuristic heuristic);
+NPUZZLE_API void npuzzle_solver_set_algorithm(NPuzzleSolver* solver, NPuzzleAlgorithm algorithm);
+// Defer linear conflict evaluation until a node is popped (non-zero to enable)
+NPUZZLE_API void npuzzle_solver_set_lazy_heuristic(NPuzzleSolver* solver, int enabled);
+// Wall-clock limit per solve in milliseconds (0 for none)
+NPUZZLE_API void npuzzle_solver_set_deadline_ms(NPuzzleSolver* solver, long milliseconds);
+// Maximum stored nodes per solve (0 for none)
+NPUZZLE_API void npuzzle_solver_set_node_budget(NPuzzleSolver* solver, long max_nodes);
+// Solves stop with NPUZZLE_CANCELLED once *flag becomes non-zero (NULL to clear); the flag
+// is a sig_atomic_t so that signal handlers may set it
+NPUZZLE_API void npuzzle_solver_set_cancel_flag(NPuzzleSolver* solver, volatile const sig_atomic_t* flag);
+// Calls fn every interval expansions from the solving thread (NULL to clear)
+NPUZZLE_API void npuzzle_solver_set_progress_callback(NPuzzleSolver* solver, NPuzzleProgressFn fn,
+                                                      void* user_data, long interval);
+// Precomputes the exact distance of every state within radius moves of the goal (perimeter
+// search); solves starting inside it need no search. Negative radius removes it.
+// Returns 0, leaving no perimeter set, if the radius is above 40, the ball would hold more than
+// 2^24 states (on 4x4 boards radius 21 fits, 22 does not) or memory runs out
+NPUZZLE_API int npuzzle_solver_set_perimeter(NPuzzleSolver* solver, int radius);
+// Snapshot every solve to path every interval seconds and when it stops on its deadline
+// or cancel flag (NULL to disable); a checkpointing context must not solve concurrently.
+// Returns 0, keeping the previous setting, if memory runs out
+NPUZZLE_API int npuzzle_solver_set_checkpoint(NPuzzleSolver* solver, const char* path,
+                                              double interval_seconds);
+
+NPUZZLE_API NPuzzleStatus npuzzle_solve(const NPuzzleSolver* solver, const int* board,
+                                        NPuzzleResult* result);
+// Continues the solve saved in a checkpoint; the context needs the goal and settings it was taken with
+NPUZZLE_API NPuzzleStatus npuzzle_resume(const NPuzzleSolver* solver, const char* path,
+                                         NPuzzleResult* result);
+// Returns non-zero if moves take board to the context's goal (replays the moves, no search)
+NPUZZLE_API int npuzzle_verify(const NPuzzleSolver* solver, const int* board, const char* moves);
+NPUZZLE_API void npuzzle_result_free(NPuzzleResult* result);
+NPUZZLE_API const char* npuzzle_status_string(NPuzzleStatus status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -110,13 +110,68 @@ void display_heuristic_menu() {
     printf("\n=== HEURISTIC SELECTION ===\n");
     printf("1. Tiles Out of Place\n");
     printf("2. Manhattan Distance\n");
-    printf("Choose heuristic (1-2): ");
+    printf("3. Linear Conflict\n");
+    printf("Choose heuristic (1-3): ");
+}
+
+/**
+ * Prints command line usage for the non-interactive modes
+ */
+void print_usage(const char* program) {
+    printf("Usage: %s                 interactive menu\n", program);
+    printf("       %s --bfs DIR [--size N] [--run-states K] [--max-depth D] [--keep-layers]\n",
+           program);
+    printf("       %s --daemon SOCKET [--workers K] [--max-nodes N] [--perimeter R]\n", program);
+    printf("       %s --solve \"TILES\" [--heuristic NAME] [--algorithm NAME] [--lazy] [--deadline-ms MS]\n"
+           "                [--max-nodes N] [--progress K] [--checkpoint FILE [--checkpoint-every SECONDS]]\n"
+           "                [--encoding plain|rle|binary] [--show-boards] [--perimeter R]\n", program);
+    printf("       %s --resume FILE [--checkpoint-every SECONDS] [--deadline-ms MS] [--progress K]\n", program);
+    printf("       %s --verify \"TILES\" --moves MOVES [--encoding plain|rle|binary] [--length N]\n", program);
+    printf("       %s --generate FILE --count N [--size N] [--walk DEPTH [--exact]] [--seed S]\n", program);
+    printf("       %s --batch FILE [--heuristic NAME] [--algorithm astar|epea|compare] [--lazy]\n"
+           "                [--max-nodes N] [--limit K] [--per-instance] [--perimeter R]\n", program);
+    printf("       %s --profile FILE [--heuristics all|NAME,NAME...] [--format json|csv] [--algorithm NAME]\n"
+           "                [--lazy] [--max-nodes N] [--limit K]\n", program);
+}
+
+/**
+ * Dispatches a non-interactive mode selected on the command line
+ */
+int run_command(int argc, char* argv[]) {
+    if (strcmp(argv[1], "--bfs") == 0) {
+        return run_external_bfs_command(argc, argv);
+    }
+    if (strcmp(argv[1], "--daemon") == 0) {
+        return run_daemon_command(argc, argv);
+    }
+    if (strcmp(argv[1], "--solve") == 0 || strcmp(argv[1], "--resume") == 0) {
+        return run_solve_command(argc, argv);
+    }
+    if (strcmp(argv[1], "--verify") == 0) {
+        return run_verify_command(argc, argv);
+    }
+    if (strcmp(argv[1], "--generate") == 0) {
+        return run_generate_command(argc, argv);
+    }
+    if (strcmp(argv[1], "--batch") == 0) {
+        return run_batch_command(argc, argv);
+    }
+    if (strcmp(argv[1], "--profile") == 0) {
+        return run_profile_command(argc, argv);
+    }
+
+    print_usage(argv[0]);
+    return 1;
 }
 
 /**
  * Main function - Entry point of the program
  */
-int main() {
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        return run_command(argc, argv);
+    }
+
     printf("=================================================\n");
     printf("        N-PUZZLE SOLVER USING A* ALGORITHM      \n");
     printf("=================================================\n");
@@ -126,7 +181,7 @@ int main() {
     int initial[MAX_SIZE][MAX_SIZE];
     int goal[MAX_SIZE][MAX_SIZE];
     int n = 3;  // Default 3x3 puzzle
-    int choice, heuristic_choice;
+    int choice, heuristic_choice, boards_choice;
     HeuristicType heuristic_type;
 
     while (1) {
@@ -164,6 +219,11 @@ int main() {
                     printf("Invalid goal puzzle configuration!\n");
                     continue;
                 }
+
+                if (!is_solvable(initial, goal, n)) {
+                    printf("This goal cannot be reached from the initial state (parity mismatch)!\n");
+                    continue;
+                }
                 break;
 
             case 4:
@@ -192,12 +252,19 @@ int main() {
             case 2:
                 heuristic_type = MANHATTAN_DISTANCE;
                 break;
+            case 3:
+                heuristic_type = LINEAR_CONFLICT;
+                break;
             default:
                 printf("Invalid choice! Using Manhattan Distance.\n");
                 heuristic_type = MANHATTAN_DISTANCE;
                 break;
         }
 
+        // Boards for every solution step are opt-in; the move string is always shown
+        printf("Show the board for every solution step? (1 = yes, 0 = no): ");
+        if (scanf("%d", &boards_choice) != 1) boards_choice = 0;
+
         // Perform A* search
         printf("\n=================================================\n");
         struct TreeNode* solution_tree = a_star_search(initial, goal, n, heuristic_type);
@@ -207,7 +274,7 @@ int main() {
             struct TreeNode* goal_node = find_goal_node(solution_tree);
 
             if (goal_node) {
-                print_solution_path(goal_node);
+                print_solution_path(goal_node, n, boards_choice == 1);
                 print_search_statistics(solution_tree, goal_node);
                 display_final_search_tree(solution_tree);
             }
@@ -6,16 +6,30 @@
 #include <string.h>
 #include <math.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <signal.h>
 
 #define MAX_SIZE 4
 #define MAX_NODES 1000
+#define NUM_MOVES 4
+#define NO_MOVE 0xFF                 // Move of a root node
+
+// Packed puzzle state: 4 bits per cell, row-major, cell 0 in the lowest nibble
+typedef uint64_t PackedState;
+
+// Blank tile moves: up, down, left, right
+extern const int MOVE_DELTAS[NUM_MOVES][2];
+extern const char MOVE_CHARS[NUM_MOVES];
 
 // Heuristic function types
 typedef enum {
     TILES_OUT_OF_PLACE,
-    MANHATTAN_DISTANCE
+    MANHATTAN_DISTANCE,
+    LINEAR_CONFLICT
 } HeuristicType;
 
+#define NUM_TABLE_HEURISTICS 2       // Heuristics with incremental operator tables
+
 // Tree node structure for N-Puzzle states
 struct TreeNode {
     int puzzle[MAX_SIZE][MAX_SIZE];  // Puzzle state
@@ -43,6 +57,8 @@ int calculate_heuristic(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_S
                         int n, HeuristicType type);
 int tiles_out_of_place(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE], int n);
 int manhattan_distance(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE], int n);
+int linear_conflict(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE], int n);
+int line_conflict_penalty(const int* goal_positions, int count);
 bool is_goal_state(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE], int n);
 struct TreeNode* a_star_search(int initial[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE],
                                int n, HeuristicType heuristic_type);
@@ -52,7 +68,7 @@ struct TreeNode* find_min_f_node(struct TreeNode** open_list, int* open_count);
 bool is_in_closed_list(struct TreeNode** closed_list, int closed_count,
                        int puzzle[MAX_SIZE][MAX_SIZE], int n);
 void print_puzzle(int puzzle[MAX_SIZE][MAX_SIZE], int n);
-void print_solution_path(struct TreeNode* goal_node);
+void print_solution_path(struct TreeNode* goal_node, int n, bool show_boards);
 void print_search_tree(struct TreeNode* root, int level);
 void print_search_statistics(struct TreeNode* root, struct TreeNode* goal_node);
 void display_final_search_tree(struct TreeNode* root);
@@ -60,4 +76,300 @@ void free_tree(struct TreeNode* node);
 int count_nodes_in_tree(struct TreeNode* root);
 struct TreeNode* find_goal_node(struct TreeNode* root);
 
+// Packed state operations
+PackedState pack_state(int puzzle[MAX_SIZE][MAX_SIZE], int n);
+void unpack_state(PackedState state, int puzzle[MAX_SIZE][MAX_SIZE], int n);
+int packed_blank_cell(PackedState state, int n);
+bool packed_move(PackedState state, int blank_cell, int direction, int n,
+                 PackedState* next, int* next_blank_cell);
+void default_goal_state(int goal[MAX_SIZE][MAX_SIZE], int n);
+bool is_permutation_board(const int* board, int n);
+bool is_permutation_state(PackedState state, int n);
+bool is_solvable(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE], int n);
+
+// External-memory breadth-first search
+struct ExtBfsOptions {
+    const char* work_dir;            // Directory holding layer and run files
+    size_t run_states;               // States buffered in RAM per sorted run
+    int max_depth;                   // Stop after this layer (-1 for a full sweep)
+    bool keep_layers;                // Keep layers older than the dedup window
+};
+
+int external_bfs(int goal[MAX_SIZE][MAX_SIZE], int n, const struct ExtBfsOptions* options);
+int run_external_bfs_command(int argc, char* argv[]);
+
+// Per-goal lookup tables, built once and shared read-only by every solve
+struct HeuristicTables {
+    int n;
+    PackedState goal;
+    int goal_cell[MAX_SIZE * MAX_SIZE];                      // Goal cell of each tile
+    int distance[MAX_SIZE * MAX_SIZE][MAX_SIZE * MAX_SIZE];  // Manhattan distance of tile from cell
+    // Change in f when the blank at a cell moves in a direction, by moved tile
+    // (indexed [heuristic][blank cell][direction][tile]; used by EPEA*)
+    signed char operator_delta_f[NUM_TABLE_HEURISTICS][MAX_SIZE * MAX_SIZE][NUM_MOVES][MAX_SIZE * MAX_SIZE];
+};
+
+// Search algorithm used by solve_puzzle
+typedef enum {
+    SEARCH_ASTAR,                    // Plain A*: every child is generated and stored
+    SEARCH_EPEA                      // Enhanced Partial Expansion A*
+} SearchAlgorithm;
+
+// Outcome of a solve
+typedef enum {
+    SOLVE_FOUND,                     // Optimal solution found
+    SOLVE_NO_SOLUTION,               // Search space exhausted
+    SOLVE_NODE_LIMIT,                // Node budget exceeded
+    SOLVE_DEADLINE,                  // Deadline passed
+    SOLVE_CANCELLED,                 // Cancel flag raised
+    SOLVE_BAD_CHECKPOINT,            // Checkpoint unreadable or taken with other settings
+    SOLVE_OUT_OF_MEMORY              // Search memory could not be allocated
+} SolveStatus;
+
+// Snapshot passed to progress callbacks
+struct SolveProgress {
+    long nodes_expanded;
+    long open_size;
+    int f;                           // f value currently being expanded
+    double elapsed_seconds;
+};
+
+// Hash index over an array of records that start with a PackedState
+#define STATE_NOT_FOUND UINT32_MAX
+
+struct StateIndex {
+    uint32_t* slots;                 // Hash slots holding record index + 1 (0 = empty)
+    size_t slot_mask;
+    size_t stride;                   // Record size in bytes
+};
+
+uint64_t hash_packed_state(PackedState state);
+bool state_index_init(struct StateIndex* index, size_t stride, size_t capacity);
+void state_index_free(struct StateIndex* index);
+bool state_index_resize(struct StateIndex* index, const void* records, size_t count, size_t capacity);
+bool state_index_add(struct StateIndex* index, const void* records, uint32_t record);
+uint32_t state_index_find(const struct StateIndex* index, const void* records, PackedState state);
+size_t state_index_bytes(const struct StateIndex* index);
+
+// Perimeter: every state within radius moves of the goal with its exact distance
+#define MAX_PERIMETER_RADIUS 40
+#define PERIMETER_MAX_STATES (1u << 24)  // About 300 MB with the index; 4x4 fits radius 21, not 22
+
+struct Perimeter {
+    int n;
+    int radius;
+    PackedState goal;
+    PackedState* states;             // Ball states in BFS order
+    uint8_t* distance;               // Exact distance to the goal
+    uint8_t* next_move;              // Blank move one step closer to the goal
+    size_t count;
+    size_t capacity;
+    struct StateIndex index;         // Position of each state in states
+};
+
+bool grow_perimeter(struct Perimeter* perimeter, PackedState goal, int n, int radius, bool truncate);
+bool build_perimeter(struct Perimeter* perimeter, PackedState goal, int n, int radius);
+bool build_capped_perimeter(struct Perimeter* perimeter, PackedState goal, int n, int radius);
+void free_perimeter(struct Perimeter* perimeter);
+int perimeter_distance(const struct Perimeter* perimeter, PackedState state);
+int perimeter_tail(const struct Perimeter* perimeter, PackedState state, char* moves);
+
+// Search options; a zeroed struct means plain A* with no limits
+struct SolveOptions {
+    SearchAlgorithm algorithm;
+    bool lazy_heuristic;             // Queue children under Manhattan, evaluate the heuristic when popped
+    long max_nodes;                  // Maximum stored nodes (0 for unlimited)
+    double deadline;                 // Absolute monotonic_seconds() deadline (0 for none)
+    volatile const sig_atomic_t* cancel; // Search stops once *cancel is non-zero
+    void (*progress)(const struct SolveProgress* progress, void* user_data);
+    void* progress_user_data;
+    long progress_interval;          // Expansions between progress callbacks
+    const char* checkpoint_path;     // Snapshot the search to this file (NULL for none)
+    double checkpoint_interval;      // Seconds between snapshots
+    const char* resume_path;         // Continue the search saved in this checkpoint
+    const struct Perimeter* perimeter;   // Exact-distance ball around the goal (NULL for none)
+};
+
+// Solution and statistics of a solve
+struct SolveResult {
+    SolveStatus status;
+    char* moves;                     // Blank moves as a string of U/D/L/R (malloc'ed)
+    int length;                      // Number of moves
+    long nodes_expanded;
+    long nodes_generated;
+    long nodes_stored;
+    long peak_open;
+    long heuristic_evaluations;      // Full (non-incremental) heuristic evaluations
+    long lazy_reinsertions;          // Popped nodes re-queued after their f rose
+    size_t memory_bytes;             // Peak node pool, hash table and open list size
+    long checkpoints_written;        // Snapshots completed during the solve
+    double elapsed_seconds;          // Includes time spent before a resumed checkpoint
+};
+
+// Node of the search graph
+struct SearchNode {
+    PackedState state;
+    uint32_t parent;                 // Index of parent node (NO_NODE for the root)
+    uint16_t g;                      // Cost from start
+    uint16_t h;                      // Heuristic cost to goal
+    uint8_t blank;                   // Cell of the empty tile
+    uint8_t move;                    // Blank move that produced this node
+    uint8_t closed;                  // 1 once expanded
+    uint8_t cheap_h;                 // Manhattan distance (lazy evaluation bound)
+    uint8_t exact;                   // 1 once h holds the full heuristic value
+    uint8_t in_ball;                 // 1 if inside the perimeter; h is then the exact distance
+};
+
+// Open list entry; stale entries are skipped when popped
+struct OpenEntry {
+    uint32_t node;
+    uint16_t f;
+    uint16_t g;
+};
+
+// Working memory of a single solve
+struct SearchSpace {
+    const struct HeuristicTables* tables;
+    HeuristicType heuristic_type;
+    struct SearchNode* nodes;
+    size_t node_count;
+    size_t node_capacity;
+    struct StateIndex index;         // Node holding each state
+    struct OpenEntry* open;
+    size_t open_count;
+    size_t open_capacity;
+    bool out_of_memory;              // Set by the first failed allocation
+};
+
+void build_heuristic_tables(struct HeuristicTables* tables, int goal[MAX_SIZE][MAX_SIZE], int n);
+int packed_heuristic(const struct HeuristicTables* tables, PackedState state, HeuristicType type);
+bool solve_puzzle(const struct HeuristicTables* tables, int initial[MAX_SIZE][MAX_SIZE],
+                  HeuristicType heuristic_type, const struct SolveOptions* options,
+                  struct SolveResult* result);
+void free_solve_result(struct SolveResult* result);
+const char* solve_status_name(SolveStatus status);
+bool parse_heuristic_name(const char* name, HeuristicType* type);
+const char* heuristic_name(HeuristicType type);
+const char* heuristic_option_name(HeuristicType type);
+bool parse_algorithm_name(const char* name, SearchAlgorithm* algorithm);
+const char* algorithm_name(SearchAlgorithm algorithm);
+double monotonic_seconds(void);
+void* search_alloc(void* ptr, size_t count, size_t size);
+bool search_space_reserve(struct SearchSpace* space, size_t node_count, size_t open_count);
+
+// Search checkpoint: a CheckpointHeader, node_count SearchNodes, then open_count OpenEntries
+#define CHECKPOINT_MAGIC "NPZCKPT1"
+#define CHECKPOINT_VERSION 2
+
+struct CheckpointHeader {
+    char magic[8];                   // CHECKPOINT_MAGIC (not NUL-terminated)
+    uint32_t version;
+    uint32_t header_size;            // Offset of the first node
+    uint32_t n;                      // Board size
+    uint32_t heuristic;              // HeuristicType of the search
+    uint32_t algorithm;              // SearchAlgorithm of the search
+    uint32_t lazy_heuristic;
+    uint32_t node_size;              // sizeof(struct SearchNode)
+    uint32_t open_entry_size;        // sizeof(struct OpenEntry)
+    int32_t perimeter_radius;        // Radius of the perimeter searched with (-1 for none)
+    uint32_t reserved;
+    PackedState initial;
+    PackedState goal;
+    uint64_t node_count;
+    uint64_t open_count;
+    int64_t nodes_expanded;
+    int64_t nodes_generated;
+    int64_t peak_open;
+    int64_t heuristic_evaluations;
+    int64_t lazy_reinsertions;
+    double elapsed_seconds;
+};
+
+// Background checkpoint writer (a forked child process)
+struct CheckpointWriter {
+    long pid;                        // Running writer, or 0
+    long completed;                  // Snapshots written successfully
+};
+
+bool write_checkpoint_file(const char* path, const struct CheckpointHeader* header,
+                           const struct SearchSpace* space);
+bool start_checkpoint(struct CheckpointWriter* writer, const char* path,
+                      const struct CheckpointHeader* header, const struct SearchSpace* space);
+void finish_checkpoint(struct CheckpointWriter* writer, bool wait);
+bool read_checkpoint_header(const char* path, struct CheckpointHeader* header);
+bool valid_checkpoint_node(const struct SearchNode* nodes, size_t node_count, size_t index,
+                           const struct CheckpointHeader* header);
+bool load_checkpoint(const char* path, struct SearchSpace* space, struct CheckpointHeader* header);
+
+// Resident solver daemon
+int run_daemon_command(int argc, char* argv[]);
+
+// Single-board command line solve through libnpuzzle
+int parse_board_string(const char* text, int* board);
+int run_solve_command(int argc, char* argv[]);
+int run_verify_command(int argc, char* argv[]);
+
+// Packed instance corpus: a CorpusHeader followed by count PackedState records
+#define CORPUS_MAGIC "NPZCORP1"
+#define CORPUS_VERSION 1
+
+struct CorpusHeader {
+    char magic[8];                   // CORPUS_MAGIC (not NUL-terminated)
+    uint32_t version;
+    uint32_t header_size;            // Offset of the first record
+    uint32_t n;                      // Board size
+    uint32_t record_size;            // sizeof(PackedState)
+    uint64_t count;                  // Number of records
+    PackedState goal;                // Goal every instance is solved towards
+    uint64_t seed;                   // Generator seed
+    uint32_t walk_depth;             // Random-walk depth (0 for uniform random)
+    uint32_t flags;                  // CORPUS_EXACT_DEPTH if walk_depth is optimal
+    uint32_t reserved[2];
+};
+
+#define CORPUS_EXACT_DEPTH 1u
+
+// Read-only memory-mapped corpus
+struct Corpus {
+    int fd;
+    size_t map_size;
+    const struct CorpusHeader* header;
+    const PackedState* records;
+    uint64_t count;
+};
+
+bool corpus_open(struct Corpus* corpus, const char* path);
+void corpus_close(struct Corpus* corpus);
+FILE* corpus_create(const char* path, const struct CorpusHeader* header);
+bool corpus_finish(FILE* fp, struct CorpusHeader* header, uint64_t count);
+
+// Instance generator and corpus batch solver
+int run_generate_command(int argc, char* argv[]);
+int run_batch_command(int argc, char* argv[]);
+
+// Compact solutions: move strings with optional run-length or 2-bit encoding
+typedef enum {
+    MOVES_PLAIN,                     // One character per move ("ULDR...")
+    MOVES_RLE,                       // Move followed by its repeat count ("U3LD2")
+    MOVES_BINARY                     // 2 bits per move, printed as hex
+} MoveEncoding;
+
+int move_direction(char move);
+bool replay_moves(PackedState* state, const char* moves, int length, int n);
+bool verify_solution(PackedState initial, PackedState goal, const char* moves, int length, int n);
+char* encode_moves_rle(const char* moves, int length);
+bool parse_run_length(const char** p, long total, long* run);
+char* decode_moves_rle(const char* text, int* length);
+bool pack_moves(const char* moves, int length, uint8_t* data);
+void unpack_moves(const uint8_t* data, int length, char* moves);
+char* decode_moves_hex(const char* text, int length);
+char* tree_solution_moves(struct TreeNode* goal_node);
+bool print_moves(const char* moves, int length, MoveEncoding encoding);
+bool parse_move_encoding(const char* name, MoveEncoding* encoding);
+void print_move_boards(PackedState initial, const char* moves, int length, int n);
+
+// Heuristic effectiveness profiler over a corpus
+double effective_branching_factor(long generated, int depth);
+int run_profile_command(int argc, char* argv[]);
+
 #endif
\ No newline at end of file
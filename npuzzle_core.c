@@ -1,5 +1,8 @@
 #include "npuzzle.h"
 
+const int MOVE_DELTAS[NUM_MOVES][2] = {{-1, 0}, {1, 0}, {0, -1}, {0, 1}};
+const char MOVE_CHARS[NUM_MOVES] = {'U', 'D', 'L', 'R'};
+
 /**
  * Creates a new tree node with the given puzzle state
  */
@@ -177,3 +180,161 @@ void free_tree(struct TreeNode* node) {
     }
     free(node);
 }
+
+/**
+ * Packs a puzzle state into 64 bits (4 bits per cell)
+ */
+PackedState pack_state(int puzzle[MAX_SIZE][MAX_SIZE], int n) {
+    PackedState state = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            state |= (PackedState)puzzle[i][j] << (4 * (i * n + j));
+        }
+    }
+    return state;
+}
+
+/**
+ * Unpacks a 64-bit state back into a puzzle grid
+ */
+void unpack_state(PackedState state, int puzzle[MAX_SIZE][MAX_SIZE], int n) {
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            puzzle[i][j] = (int)((state >> (4 * (i * n + j))) & 0xF);
+        }
+    }
+}
+
+/**
+ * Finds the cell index of the empty tile in a packed state
+ */
+int packed_blank_cell(PackedState state, int n) {
+    for (int cell = 0; cell < n * n; cell++) {
+        if (((state >> (4 * cell)) & 0xF) == 0) {
+            return cell;
+        }
+    }
+    return -1;
+}
+
+/**
+ * Moves the empty tile of a packed state in the given direction
+ * Returns false if the move would leave the board
+ */
+bool packed_move(PackedState state, int blank_cell, int direction, int n,
+                 PackedState* next, int* next_blank_cell) {
+    int new_row = blank_cell / n + MOVE_DELTAS[direction][0];
+    int new_col = blank_cell % n + MOVE_DELTAS[direction][1];
+    if (!is_valid_move(new_row, new_col, n)) {
+        return false;
+    }
+    
+    // The blank nibble is zero, so the tile can be or-ed straight into it
+    int new_cell = new_row * n + new_col;
+    PackedState tile = (state >> (4 * new_cell)) & 0xF;
+    *next = (state & ~((PackedState)0xF << (4 * new_cell))) | (tile << (4 * blank_cell));
+    *next_blank_cell = new_cell;
+    return true;
+}
+
+/**
+ * Builds the snail-shaped goal state used by the default puzzles
+ * (tiles spiral clockwise from the top-left corner, blank in the last cell the
+ * spiral reaches: the centre for odd n, [2][1] on 4x4)
+ */
+void default_goal_state(int goal[MAX_SIZE][MAX_SIZE], int n) {
+    int top = 0, bottom = n - 1, left = 0, right = n - 1;
+    int value = 1;
+    
+    // The spiral stops before filling its last cell, which stays as the blank
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            goal[i][j] = 0;
+        }
+    }
+    
+    while (value < n * n) {
+        for (int j = left; j <= right && value < n * n; j++) goal[top][j] = value++;
+        top++;
+        for (int i = top; i <= bottom && value < n * n; i++) goal[i][right] = value++;
+        right--;
+        for (int j = right; j >= left && value < n * n; j--) goal[bottom][j] = value++;
+        bottom--;
+        for (int i = bottom; i >= top && value < n * n; i--) goal[i][left] = value++;
+        left++;
+    }
+}
+
+/**
+ * Checks that a board is a permutation of 0..n*n-1
+ */
+bool is_permutation_board(const int* board, int n) {
+    bool seen[MAX_SIZE * MAX_SIZE] = {false};
+
+    for (int cell = 0; cell < n * n; cell++) {
+        if (board[cell] < 0 || board[cell] >= n * n || seen[board[cell]]) {
+            return false;
+        }
+        seen[board[cell]] = true;
+    }
+    return true;
+}
+
+/**
+ * Checks that a packed state holds a permutation of 0..n*n-1 with its unused high bits clear
+ */
+bool is_permutation_state(PackedState state, int n) {
+    int board[MAX_SIZE * MAX_SIZE];
+
+    if (n < 4 && (state >> (4 * n * n)) != 0) {
+        return false;
+    }
+    for (int cell = 0; cell < n * n; cell++) {
+        board[cell] = (int)((state >> (4 * cell)) & 0xF);
+    }
+    return is_permutation_board(board, n);
+}
+
+/**
+ * Checks whether the goal can be reached from a state
+ * Every move swaps the blank with a neighbour, flipping the parity of the
+ * tile permutation and of the blank's distance to its goal cell together,
+ * so the two parities must match.
+ */
+bool is_solvable(int puzzle[MAX_SIZE][MAX_SIZE], int goal[MAX_SIZE][MAX_SIZE], int n) {
+    int goal_cell[MAX_SIZE * MAX_SIZE];
+    int target[MAX_SIZE * MAX_SIZE];
+    bool visited[MAX_SIZE * MAX_SIZE] = {false};
+    
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            goal_cell[goal[i][j]] = i * n + j;
+        }
+    }
+    
+    // Permutation mapping each cell to the goal cell of its tile
+    int blank_row = 0, blank_col = 0;
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            target[i * n + j] = goal_cell[puzzle[i][j]];
+            if (puzzle[i][j] == 0) {
+                blank_row = i;
+                blank_col = j;
+            }
+        }
+    }
+    
+    // A cycle of length k is k-1 transpositions
+    int transpositions = 0;
+    for (int cell = 0; cell < n * n; cell++) {
+        int length = 0;
+        for (int c = cell; !visited[c]; c = target[c]) {
+            visited[c] = true;
+            length++;
+        }
+        if (length > 0) transpositions += length - 1;
+    }
+    
+    int blank_distance = abs(blank_row - goal_cell[0] / n) + abs(blank_col - goal_cell[0] % n);
+    return (transpositions % 2) == (blank_distance % 2);
+}
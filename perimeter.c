@@ -0,0 +1,171 @@
+#include "npuzzle.h"
+
+#define PERIMETER_INITIAL_CAPACITY 1024
+
+/*
+ * Perimeter search tables.
+ *
+ * A perimeter is the ball of every state within radius moves of the goal,
+ * found by a breadth-first search outward from the goal. Moves are
+ * reversible, so the BFS depth of a state is its exact distance to the
+ * goal. Each state also keeps the blank move that steps back towards the
+ * goal (the reverse of the move that first reached it), so the optimal
+ * tail from any state in the ball is read off by following those moves.
+ *
+ * States are appended in BFS order and indexed by a StateIndex, the same
+ * hash table the search engine uses for its node pool.
+ *
+ * The ball grows roughly by the branching factor per layer, so a radius
+ * that is harmless on 3x3 boards (whose whole space is 181,440 states) is
+ * far too large on 4x4. Instead of a cap per board size, a build stops and
+ * fails once the ball would exceed PERIMETER_MAX_STATES, or with a capped
+ * build keeps only the layers that fit.
+ */
+
+/**
+ * Finds the index of a state in the ball, or STATE_NOT_FOUND
+ */
+uint32_t perimeter_index(const struct Perimeter* perimeter, PackedState state) {
+    return state_index_find(&perimeter->index, perimeter->states, state);
+}
+
+/**
+ * Appends a state to the ball and indexes it
+ * Returns false if the ball is full or memory runs out
+ */
+bool perimeter_add(struct Perimeter* perimeter, PackedState state, int distance, int next_move) {
+    if (perimeter->count >= PERIMETER_MAX_STATES) return false;
+    if (perimeter->count == perimeter->capacity) {
+        size_t capacity = 2 * perimeter->capacity;
+        PackedState* states = (PackedState*)search_alloc(perimeter->states, capacity, sizeof(PackedState));
+        if (!states) return false;
+        perimeter->states = states;
+        uint8_t* distances = (uint8_t*)search_alloc(perimeter->distance, capacity, 1);
+        if (!distances) return false;
+        perimeter->distance = distances;
+        uint8_t* next_moves = (uint8_t*)search_alloc(perimeter->next_move, capacity, 1);
+        if (!next_moves) return false;
+        perimeter->next_move = next_moves;
+        perimeter->capacity = capacity;
+    }
+
+    uint32_t index = (uint32_t)perimeter->count;
+    perimeter->states[index] = state;
+    perimeter->distance[index] = (uint8_t)distance;
+    perimeter->next_move[index] = (uint8_t)next_move;
+    if (!state_index_add(&perimeter->index, perimeter->states, index)) return false;
+    perimeter->count++;
+    return true;
+}
+
+/**
+ * Grows the ball layer by layer up to radius moves from the goal
+ * With truncate set, a layer that would take the ball past PERIMETER_MAX_STATES
+ * is dropped and the radius lowered to the last complete layer instead
+ */
+bool grow_perimeter(struct Perimeter* perimeter, PackedState goal, int n, int radius, bool truncate) {
+    memset(perimeter, 0, sizeof(*perimeter));
+    if (radius < 0 || radius > MAX_PERIMETER_RADIUS) return false;
+
+    perimeter->n = n;
+    perimeter->radius = radius;
+    perimeter->goal = goal;
+    perimeter->capacity = PERIMETER_INITIAL_CAPACITY;
+    perimeter->states = (PackedState*)search_alloc(NULL, perimeter->capacity, sizeof(PackedState));
+    perimeter->distance = (uint8_t*)search_alloc(NULL, perimeter->capacity, 1);
+    perimeter->next_move = (uint8_t*)search_alloc(NULL, perimeter->capacity, 1);
+    bool indexed = state_index_init(&perimeter->index, sizeof(PackedState), PERIMETER_INITIAL_CAPACITY);
+    if (!perimeter->states || !perimeter->distance || !perimeter->next_move || !indexed ||
+        !perimeter_add(perimeter, goal, 0, NO_MOVE)) {
+        free_perimeter(perimeter);
+        return false;
+    }
+
+    // States are appended in BFS order, so each layer is a contiguous range
+    size_t layer_start = 0;
+    for (int depth = 0; depth < radius; depth++) {
+        size_t layer_end = perimeter->count;
+        for (size_t i = layer_start; i < layer_end; i++) {
+            PackedState state = perimeter->states[i];
+            int blank = packed_blank_cell(state, n);
+            for (int dir = 0; dir < NUM_MOVES; dir++) {
+                PackedState next;
+                int next_blank;
+                if (!packed_move(state, blank, dir, n, &next, &next_blank)) continue;
+                if (perimeter_index(perimeter, next) != STATE_NOT_FOUND) continue;
+                if (truncate && perimeter->count >= PERIMETER_MAX_STATES) {
+                    // Forget the partial layer; the index is rebuilt over the rest
+                    perimeter->count = layer_end;
+                    perimeter->radius = depth;
+                    if (!state_index_resize(&perimeter->index, perimeter->states, layer_end, layer_end)) {
+                        free_perimeter(perimeter);
+                        return false;
+                    }
+                    return true;
+                }
+                // Directions come in opposite pairs: up/down, left/right
+                if (!perimeter_add(perimeter, next, depth + 1, dir ^ 1)) {
+                    free_perimeter(perimeter);
+                    return false;
+                }
+            }
+        }
+        if (perimeter->count == layer_end) break;   // Whole state space covered
+        layer_start = layer_end;
+    }
+    return true;
+}
+
+/**
+ * Builds the ball of states within radius moves of the goal
+ * Returns false, with the perimeter left empty, if the radius is out of range,
+ * the ball holds more than PERIMETER_MAX_STATES states or memory runs out
+ */
+bool build_perimeter(struct Perimeter* perimeter, PackedState goal, int n, int radius) {
+    return grow_perimeter(perimeter, goal, n, radius, false);
+}
+
+/**
+ * Builds the largest ball of at most radius moves that fits in PERIMETER_MAX_STATES
+ * perimeter->radius holds the radius reached; returns false if the radius is out
+ * of range or memory runs out
+ */
+bool build_capped_perimeter(struct Perimeter* perimeter, PackedState goal, int n, int radius) {
+    return grow_perimeter(perimeter, goal, n, radius, true);
+}
+
+void free_perimeter(struct Perimeter* perimeter) {
+    free(perimeter->states);
+    free(perimeter->distance);
+    free(perimeter->next_move);
+    state_index_free(&perimeter->index);
+    memset(perimeter, 0, sizeof(*perimeter));
+}
+
+/**
+ * Returns the exact distance of a state to the goal if it lies in the ball, or -1
+ */
+int perimeter_distance(const struct Perimeter* perimeter, PackedState state) {
+    uint32_t index = perimeter_index(perimeter, state);
+    return index == STATE_NOT_FOUND ? -1 : perimeter->distance[index];
+}
+
+/**
+ * Writes the optimal moves from a state in the ball to the goal
+ * Returns the number of moves written, or -1 if the state is outside the ball
+ */
+int perimeter_tail(const struct Perimeter* perimeter, PackedState state, char* moves) {
+    int n = perimeter->n;
+    int length = 0;
+    uint32_t index = perimeter_index(perimeter, state);
+    if (index == STATE_NOT_FOUND) return -1;
+
+    int blank = packed_blank_cell(state, n);
+    while (perimeter->distance[index] > 0) {
+        int dir = perimeter->next_move[index];
+        moves[length++] = MOVE_CHARS[dir];
+        packed_move(state, blank, dir, n, &state, &blank);
+        index = perimeter_index(perimeter, state);
+    }
+    return length;
+}
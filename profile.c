@@ -0,0 +1,286 @@
+#include "npuzzle.h"
+
+#define MAX_PROFILED_HEURISTICS 3
+
+// Measurements of one heuristic over a corpus
+struct HeuristicProfile {
+    HeuristicType type;
+    long solved;
+    long failed;                     // Stopped by the node budget
+    long total_moves;
+    long nodes_expanded;
+    long nodes_generated;
+    double branching_sum;            // Sum of per-instance effective branching factors
+    double ratio_sum;                // Sum of h/h* over every state on the reference paths
+    long ratio_count;
+    double initial_ratio_sum;        // Sum of h/h* of the start states with a reference path
+    long initial_ratio_count;
+    double seconds;
+};
+
+/**
+ * Effective branching factor b* of a search: the branching factor a uniform
+ * tree of the solution depth would need to hold the generated nodes,
+ * i.e. the root of b + b^2 + ... + b^depth = generated (found by bisection)
+ */
+double effective_branching_factor(long generated, int depth) {
+    if (depth <= 0 || generated <= 0) return 0.0;
+
+    double low = 0.0, high = (double)generated + 1.0;
+    for (int iteration = 0; iteration < 100; iteration++) {
+        double b = (low + high) / 2;
+        double sum = 0.0, power = 1.0;
+        for (int i = 1; i <= depth && sum <= generated; i++) {
+            power *= b;
+            sum += power;
+        }
+        if (sum > generated) {
+            high = b;
+        } else {
+            low = b;
+        }
+    }
+    return (low + high) / 2;
+}
+
+/**
+ * Replays an optimal solution into the states along it, excluding the goal
+ * Returns the number of states stored; states[i] is length - i moves from the goal
+ */
+int collect_path_states(PackedState initial, const char* moves, int length, int n, PackedState* states) {
+    PackedState state = initial;
+    int blank = packed_blank_cell(state, n);
+
+    for (int i = 0; i < length; i++) {
+        states[i] = state;
+        int dir = move_direction(moves[i]);
+        if (dir < 0 || !packed_move(state, blank, dir, n, &state, &blank)) return i + 1;
+    }
+    return length;
+}
+
+/**
+ * Adds h/h* of every state on an optimal path to the profile
+ * The remaining path length is the exact distance h* of each state
+ */
+void add_path_ratios(const struct HeuristicTables* tables, const PackedState* states, int count, int length,
+                     struct HeuristicProfile* profile) {
+    for (int i = 0; i < count; i++) {
+        double ratio = (double)packed_heuristic(tables, states[i], profile->type) / (length - i);
+        profile->ratio_sum += ratio;
+        profile->ratio_count++;
+        if (i == 0) {
+            profile->initial_ratio_sum += ratio;
+            profile->initial_ratio_count++;
+        }
+    }
+}
+
+double profile_mean(double sum, long count) {
+    return count > 0 ? sum / count : 0.0;
+}
+
+/**
+ * Prints text as a JSON string literal
+ */
+void print_json_string(const char* text) {
+    putchar('"');
+    for (const unsigned char* p = (const unsigned char*)text; *p; p++) {
+        if (*p == '"' || *p == '\\') {
+            printf("\\%c", *p);
+        } else if (*p < 0x20) {
+            printf("\\u%04x", *p);
+        } else {
+            putchar(*p);
+        }
+    }
+    putchar('"');
+}
+
+void print_profile_json(const char* path, const struct Corpus* corpus, uint64_t count,
+                        const struct SolveOptions* options, const struct HeuristicProfile* profiles,
+                        int num_profiles) {
+    printf("{\n");
+    printf("  \"corpus\": ");
+    print_json_string(path);
+    printf(",\n");
+    printf("  \"size\": %u,\n", corpus->header->n);
+    printf("  \"instances\": %llu,\n", (unsigned long long)count);
+    printf("  \"algorithm\": \"%s\",\n", algorithm_name(options->algorithm));
+    printf("  \"lazy\": %s,\n", options->lazy_heuristic ? "true" : "false");
+    printf("  \"heuristics\": [\n");
+    for (int i = 0; i < num_profiles; i++) {
+        const struct HeuristicProfile* p = &profiles[i];
+        printf("    {\"heuristic\": \"%s\", \"name\": \"%s\", \"solved\": %ld, \"failed\": %ld, "
+               "\"mean_length\": %.3f, \"effective_branching_factor\": %.4f, \"mean_h_ratio\": %.4f, \"mean_initial_h_ratio\": %.4f, "
+               "\"nodes_expanded\": %ld, \"nodes_generated\": %ld, \"nodes_per_second\": %.0f, "
+               "\"total_seconds\": %.6f}%s\n",
+               heuristic_option_name(p->type), heuristic_name(p->type), p->solved, p->failed,
+               profile_mean(p->total_moves, p->solved), profile_mean(p->branching_sum, p->solved),
+               profile_mean(p->ratio_sum, p->ratio_count),
+               profile_mean(p->initial_ratio_sum, p->initial_ratio_count), p->nodes_expanded, p->nodes_generated,
+               p->seconds > 0 ? p->nodes_expanded / p->seconds : 0.0, p->seconds,
+               i + 1 < num_profiles ? "," : "");
+    }
+    printf("  ]\n");
+    printf("}\n");
+}
+
+void print_profile_csv(const struct HeuristicProfile* profiles, int num_profiles) {
+    printf("heuristic,solved,failed,mean_length,effective_branching_factor,mean_h_ratio,"
+           "mean_initial_h_ratio,nodes_expanded,nodes_generated,nodes_per_second,total_seconds\n");
+    for (int i = 0; i < num_profiles; i++) {
+        const struct HeuristicProfile* p = &profiles[i];
+        printf("%s,%ld,%ld,%.3f,%.4f,%.4f,%.4f,%ld,%ld,%.0f,%.6f\n", heuristic_option_name(p->type),
+               p->solved, p->failed, profile_mean(p->total_moves, p->solved),
+               profile_mean(p->branching_sum, p->solved),
+               profile_mean(p->ratio_sum, p->ratio_count),
+               profile_mean(p->initial_ratio_sum, p->initial_ratio_count),
+               p->nodes_expanded, p->nodes_generated, p->seconds > 0 ? p->nodes_expanded / p->seconds : 0.0,
+               p->seconds);
+    }
+}
+
+/**
+ * Parses a comma separated heuristic list, or "all"
+ * Returns the number of heuristics, or 0 if a name is unknown
+ */
+int parse_heuristic_list(const char* text, HeuristicType* types) {
+    if (strcmp(text, "all") == 0) {
+        types[0] = TILES_OUT_OF_PLACE;
+        types[1] = MANHATTAN_DISTANCE;
+        types[2] = LINEAR_CONFLICT;
+        return 3;
+    }
+
+    int count = 0;
+    char name[32];
+    while (*text) {
+        size_t length = strcspn(text, ",");
+        if (length == 0 || length >= sizeof(name) || count == MAX_PROFILED_HEURISTICS) return 0;
+        memcpy(name, text, length);
+        name[length] = '\0';
+        if (!parse_heuristic_name(name, &types[count++])) return 0;
+        text += length;
+        if (*text == ',') text++;
+    }
+    return count;
+}
+
+/**
+ * Command line entry: npuzzle --profile FILE [--heuristics all|NAME,NAME...] [--format json|csv]
+ *                                            [--algorithm astar|epea] [--lazy] [--max-nodes N] [--limit K]
+ * Solves a corpus with each heuristic and reports how well each one guides
+ * the search, so the heuristic for a board size can be chosen from data.
+ * The h/h* ratios of every heuristic are taken over the same states: the
+ * path of the first optimal solution found for each instance.
+ */
+int run_profile_command(int argc, char* argv[]) {
+    const char* path = NULL;
+    const char* heuristics = "all";
+    const char* format = "json";
+    const char* algorithm = "astar";
+    unsigned long long limit = 0;
+    struct SolveOptions options;
+    memset(&options, 0, sizeof(options));
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--profile") == 0 && i + 1 < argc) {
+            path = argv[++i];
+        } else if (strcmp(argv[i], "--heuristics") == 0 && i + 1 < argc) {
+            heuristics = argv[++i];
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            format = argv[++i];
+        } else if (strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+            algorithm = argv[++i];
+        } else if (strcmp(argv[i], "--lazy") == 0) {
+            options.lazy_heuristic = true;
+        } else if (strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+            options.max_nodes = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--limit") == 0 && i + 1 < argc) {
+            limit = strtoull(argv[++i], NULL, 10);
+        } else {
+            printf("Unknown profile option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    HeuristicType types[MAX_PROFILED_HEURISTICS];
+    int num_profiles = parse_heuristic_list(heuristics, types);
+    bool csv = strcmp(format, "csv") == 0;
+    if (!path || num_profiles == 0 || (!csv && strcmp(format, "json") != 0) ||
+        !parse_algorithm_name(algorithm, &options.algorithm)) {
+        printf("Usage: npuzzle --profile FILE [--heuristics all|tiles,manhattan,linear] [--format json|csv]\n"
+               "                [--algorithm astar|epea] [--lazy] [--max-nodes N] [--limit K]\n");
+        return 1;
+    }
+
+    struct Corpus corpus;
+    if (!corpus_open(&corpus, path)) return 1;
+
+    int n = (int)corpus.header->n;
+    int goal[MAX_SIZE][MAX_SIZE];
+    struct HeuristicTables tables;
+    unpack_state(corpus.header->goal, goal, n);
+    build_heuristic_tables(&tables, goal, n);
+
+    uint64_t count = corpus.count;
+    if (limit > 0 && limit < count) count = limit;
+
+    struct HeuristicProfile profiles[MAX_PROFILED_HEURISTICS];
+    memset(profiles, 0, sizeof(profiles));
+    for (int h = 0; h < num_profiles; h++) {
+        profiles[h].type = types[h];
+    }
+
+    PackedState* path_states = NULL;
+    for (uint64_t i = 0; i < count; i++) {
+        int puzzle[MAX_SIZE][MAX_SIZE];
+        int path_length = 0, path_count = 0;
+        unpack_state(corpus.records[i], puzzle, n);
+
+        for (int h = 0; h < num_profiles; h++) {
+            struct HeuristicProfile* profile = &profiles[h];
+            struct SolveResult result;
+            solve_puzzle(&tables, puzzle, profile->type, &options, &result);
+
+            profile->nodes_expanded += result.nodes_expanded;
+            profile->nodes_generated += result.nodes_generated;
+            profile->seconds += result.elapsed_seconds;
+            if (result.status == SOLVE_FOUND) {
+                profile->solved++;
+                profile->total_moves += result.length;
+                profile->branching_sum += effective_branching_factor(result.nodes_generated, result.length);
+
+                // Every heuristic is admissible, so the first solution found is optimal
+                if (path_length == 0 && result.length > 0) {
+                    PackedState* states = (PackedState*)realloc(path_states,
+                                                                result.length * sizeof(PackedState));
+                    if (states) {
+                        path_states = states;
+                        path_length = result.length;
+                        path_count = collect_path_states(corpus.records[i], result.moves, result.length, n,
+                                                         path_states);
+                    }
+                }
+            } else if (result.status != SOLVE_NO_SOLUTION) {
+                profile->failed++;
+            }
+            free_solve_result(&result);
+        }
+
+        for (int h = 0; h < num_profiles; h++) {
+            add_path_ratios(&tables, path_states, path_count, path_length, &profiles[h]);
+        }
+    }
+    free(path_states);
+
+    if (csv) {
+        print_profile_csv(profiles, num_profiles);
+    } else {
+        print_profile_json(path, &corpus, count, &options, profiles, num_profiles);
+    }
+
+    corpus_close(&corpus);
+    return 0;
+}
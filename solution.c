@@ -0,0 +1,272 @@
+#include <ctype.h>
+#include "npuzzle.h"
+
+/*
+ * Compact solution representations.
+ *
+ * A solution is stored as the string of blank moves ("ULDR..."), one byte
+ * per move, instead of a list of boards. Two denser forms are provided for
+ * long solutions and batch output:
+ *  - run-length: a move followed by its repeat count when above one
+ *    ("UUULDD" becomes "U3LD2");
+ *  - 2-bit binary: four moves per byte, each move as its index in
+ *    MOVE_CHARS, first move in the lowest bits.
+ * Boards are only rebuilt on demand, by replaying the moves.
+ */
+
+/**
+ * Returns the direction index of a move character, or -1
+ */
+int move_direction(char move) {
+    for (int dir = 0; dir < NUM_MOVES; dir++) {
+        if (MOVE_CHARS[dir] == move) return dir;
+    }
+    return -1;
+}
+
+/**
+ * Applies a move string to a packed state
+ * Returns false if a move is unknown or would leave the board
+ */
+bool replay_moves(PackedState* state, const char* moves, int length, int n) {
+    int blank = packed_blank_cell(*state, n);
+    for (int i = 0; i < length; i++) {
+        int dir = move_direction(moves[i]);
+        if (dir < 0 || !packed_move(*state, blank, dir, n, state, &blank)) return false;
+    }
+    return true;
+}
+
+/**
+ * Checks that a move string takes the initial state to the goal
+ */
+bool verify_solution(PackedState initial, PackedState goal, const char* moves, int length, int n) {
+    PackedState state = initial;
+    return replay_moves(&state, moves, length, n) && state == goal;
+}
+
+/**
+ * Run-length encodes a move string (malloc'ed, NUL-terminated)
+ * Returns NULL if memory runs out
+ */
+char* encode_moves_rle(const char* moves, int length) {
+    // Worst case is no runs at all: one byte per move
+    char* text = (char*)malloc((size_t)length + 1);
+    if (!text) return NULL;
+
+    int out = 0;
+    for (int i = 0; i < length;) {
+        int run = 1;
+        while (i + run < length && moves[i + run] == moves[i]) run++;
+        text[out++] = moves[i];
+        if (run > 1) out += sprintf(text + out, "%d", run);
+        i += run;
+    }
+    text[out] = '\0';
+    return text;
+}
+
+/**
+ * Reads the optional decimal repeat count after a move, advancing *p past it
+ * Counts are plain digits with no sign, spaces or leading zero; a missing count
+ * means one. Returns false if the count is zero or would take total past INT32_MAX
+ */
+bool parse_run_length(const char** p, long total, long* run) {
+    const char* digits = *p;
+    *run = 1;
+    if (!isdigit((unsigned char)*digits)) return true;
+    if (*digits == '0') return false;
+
+    long value = 0;
+    while (isdigit((unsigned char)*digits)) {
+        value = value * 10 + (*digits - '0');
+        if (total + value > INT32_MAX) return false;
+        digits++;
+    }
+    *p = digits;
+    *run = value;
+    return true;
+}
+
+/**
+ * Expands a run-length encoded move string (malloc'ed, NUL-terminated)
+ * Returns NULL if the text is malformed or memory runs out
+ */
+char* decode_moves_rle(const char* text, int* length) {
+    // First pass validates and measures, second pass expands
+    long total = 0;
+    for (const char* p = text; *p;) {
+        if (move_direction(*p) < 0) return NULL;
+        long run;
+        p++;
+        if (!parse_run_length(&p, total, &run)) return NULL;
+        total += run;
+    }
+
+    char* moves = (char*)malloc((size_t)total + 1);
+    if (!moves) return NULL;
+
+    long out = 0;
+    for (const char* p = text; *p;) {
+        char move = *p++;
+        long run;
+        parse_run_length(&p, out, &run);
+        memset(moves + out, move, (size_t)run);
+        out += run;
+    }
+    moves[out] = '\0';
+    *length = (int)total;
+    return moves;
+}
+
+/**
+ * Packs a move string at 2 bits per move into data ((length + 3) / 4 bytes)
+ * Returns false if a move is unknown
+ */
+bool pack_moves(const char* moves, int length, uint8_t* data) {
+    memset(data, 0, (size_t)(length + 3) / 4);
+    for (int i = 0; i < length; i++) {
+        int dir = move_direction(moves[i]);
+        if (dir < 0) return false;
+        data[i / 4] |= (uint8_t)(dir << (2 * (i % 4)));
+    }
+    return true;
+}
+
+/**
+ * Unpacks length 2-bit moves into a NUL-terminated move string
+ */
+void unpack_moves(const uint8_t* data, int length, char* moves) {
+    for (int i = 0; i < length; i++) {
+        moves[i] = MOVE_CHARS[(data[i / 4] >> (2 * (i % 4))) & 0x3];
+    }
+    moves[length] = '\0';
+}
+
+int hex_digit_value(char digit) {
+    if (digit >= '0' && digit <= '9') return digit - '0';
+    if (digit >= 'a' && digit <= 'f') return digit - 'a' + 10;
+    if (digit >= 'A' && digit <= 'F') return digit - 'A' + 10;
+    return -1;
+}
+
+/**
+ * Decodes the hex text printed for MOVES_BINARY into length moves (malloc'ed,
+ * NUL-terminated). The byte count only bounds the length, so it must be given.
+ * Returns NULL if the text is not exactly that many packed moves with zero
+ * padding, or memory runs out
+ */
+char* decode_moves_hex(const char* text, int length) {
+    if (length < 0) return NULL;
+    size_t bytes = ((size_t)length + 3) / 4;
+    if (strlen(text) != 2 * bytes) return NULL;
+
+    uint8_t* data = (uint8_t*)malloc(bytes + 1);
+    char* moves = (char*)malloc((size_t)length + 1);
+    bool ok = data && moves;
+    for (size_t i = 0; ok && i < bytes; i++) {
+        int high = hex_digit_value(text[2 * i]);
+        int low = hex_digit_value(text[2 * i + 1]);
+        ok = high >= 0 && low >= 0;
+        if (ok) data[i] = (uint8_t)(high << 4 | low);
+    }
+    ok = ok && (length % 4 == 0 || (data[bytes - 1] >> (2 * (length % 4))) == 0);
+
+    if (ok) unpack_moves(data, length, moves);
+    free(data);
+    if (!ok) {
+        free(moves);
+        return NULL;
+    }
+    return moves;
+}
+
+/**
+ * Rebuilds the move string of a search tree path from the blank positions
+ * of consecutive nodes (malloc'ed, NUL-terminated, goal_node->depth moves)
+ * Returns NULL if memory runs out
+ */
+char* tree_solution_moves(struct TreeNode* goal_node) {
+    int length = goal_node->depth;
+    char* moves = (char*)malloc((size_t)length + 1);
+    if (!moves) return NULL;
+    moves[length] = '\0';
+
+    struct TreeNode* current = goal_node;
+    for (int i = length - 1; i >= 0 && current->parent; i--) {
+        struct TreeNode* parent = current->parent;
+        int dr = current->empty_row - parent->empty_row;
+        int dc = current->empty_col - parent->empty_col;
+        moves[i] = '?';
+        for (int dir = 0; dir < NUM_MOVES; dir++) {
+            if (MOVE_DELTAS[dir][0] == dr && MOVE_DELTAS[dir][1] == dc) moves[i] = MOVE_CHARS[dir];
+        }
+        current = parent;
+    }
+    return moves;
+}
+
+/**
+ * Prints a move string in the given encoding
+ * Returns false, printing nothing, if memory runs out
+ */
+bool print_moves(const char* moves, int length, MoveEncoding encoding) {
+    if (encoding == MOVES_RLE) {
+        char* text = encode_moves_rle(moves, length);
+        if (!text) return false;
+        printf("%s", text);
+        free(text);
+    } else if (encoding == MOVES_BINARY) {
+        uint8_t* data = (uint8_t*)malloc((size_t)(length + 3) / 4 + 1);
+        if (!data) return false;
+        pack_moves(moves, length, data);
+        for (int i = 0; i < (length + 3) / 4; i++) {
+            printf("%02x", data[i]);
+        }
+        free(data);
+    } else {
+        printf("%s", moves);
+    }
+    return true;
+}
+
+/**
+ * Parses a move encoding name as used on the command line
+ */
+bool parse_move_encoding(const char* name, MoveEncoding* encoding) {
+    if (strcmp(name, "plain") == 0) {
+        *encoding = MOVES_PLAIN;
+    } else if (strcmp(name, "rle") == 0) {
+        *encoding = MOVES_RLE;
+    } else if (strcmp(name, "binary") == 0) {
+        *encoding = MOVES_BINARY;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Renders every board of a solution by replaying its moves
+ */
+void print_move_boards(PackedState initial, const char* moves, int length, int n) {
+    int puzzle[MAX_SIZE][MAX_SIZE];
+    PackedState state = initial;
+    int blank = packed_blank_cell(state, n);
+
+    for (int i = 0; i <= length; i++) {
+        if (i == 0) {
+            printf("Initial State (Step 0):\n");
+        } else {
+            printf("Step %d (%c):\n", i, moves[i - 1]);
+        }
+        unpack_state(state, puzzle, n);
+        print_puzzle(puzzle, n);
+        printf("\n");
+
+        if (i < length) {
+            int dir = move_direction(moves[i]);
+            if (dir < 0 || !packed_move(state, blank, dir, n, &state, &blank)) return;
+        }
+    }
+}
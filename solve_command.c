@@ -0,0 +1,308 @@
+#include <signal.h>
+#include "npuzzle.h"
+#include "libnpuzzle.h"
+
+#define DEFAULT_CHECKPOINT_SECONDS 60.0
+
+// Raised by SIGINT while checkpointing, so the search stops with a final snapshot
+volatile sig_atomic_t interrupt_flag = 0;
+
+void handle_solve_interrupt(int signal_number) {
+    (void)signal_number;
+    interrupt_flag = 1;
+}
+
+/**
+ * Parses a board given as space or comma separated tiles
+ * Returns the board size n, or 0 if the tile count is not a square
+ */
+int parse_board_string(const char* text, int* board) {
+    int count = 0;
+    const char* p = text;
+
+    while (*p && count < MAX_SIZE * MAX_SIZE) {
+        char* end;
+        long value = strtol(p, &end, 10);
+        if (end == p) {
+            p++;
+            continue;
+        }
+        board[count++] = (int)value;
+        p = end;
+    }
+
+    for (int n = 2; n <= MAX_SIZE; n++) {
+        if (n * n == count) return n;
+    }
+    return 0;
+}
+
+void print_solve_progress(const NPuzzleProgress* progress, void* user_data) {
+    (void)user_data;
+    printf("  ... expanded=%ld open=%ld f=%d elapsed=%.2fs\n", progress->nodes_expanded,
+           progress->open_size, progress->f, progress->elapsed_seconds);
+    fflush(stdout);
+}
+
+void configure_solver(NPuzzleSolver* solver, HeuristicType heuristic_type, SearchAlgorithm search_algorithm,
+                      bool lazy) {
+    npuzzle_solver_set_heuristic(solver, heuristic_type == TILES_OUT_OF_PLACE ? NPUZZLE_HEURISTIC_TILES
+                                         : heuristic_type == LINEAR_CONFLICT ? NPUZZLE_HEURISTIC_LINEAR_CONFLICT
+                                         : NPUZZLE_HEURISTIC_MANHATTAN);
+    npuzzle_solver_set_algorithm(solver, search_algorithm == SEARCH_EPEA
+                                         ? NPUZZLE_ALGORITHM_EPEA : NPUZZLE_ALGORITHM_ASTAR);
+    npuzzle_solver_set_lazy_heuristic(solver, lazy);
+}
+
+/**
+ * Creates a solver with the goal and settings stored in a checkpoint
+ * The board being solved is returned in board and its size in n
+ */
+NPuzzleSolver* create_resume_solver(const char* path, int* board, int* n_out) {
+    struct CheckpointHeader header;
+    if (!read_checkpoint_header(path, &header) || header.heuristic > LINEAR_CONFLICT ||
+        header.algorithm > SEARCH_EPEA) {
+        printf("Cannot read checkpoint %s.\n", path);
+        return NULL;
+    }
+
+    int n = (int)header.n;
+    int goal[MAX_SIZE][MAX_SIZE];
+    int initial[MAX_SIZE][MAX_SIZE];
+    int goal_board[MAX_SIZE * MAX_SIZE];
+    unpack_state(header.goal, goal, n);
+    unpack_state(header.initial, initial, n);
+    for (int cell = 0; cell < n * n; cell++) {
+        goal_board[cell] = goal[cell / n][cell % n];
+        board[cell] = initial[cell / n][cell % n];
+    }
+    *n_out = n;
+
+    NPuzzleSolver* solver = npuzzle_solver_create(n, goal_board);
+    if (!solver) {
+        printf("Checkpoint %s has an invalid goal.\n", path);
+        return NULL;
+    }
+    configure_solver(solver, (HeuristicType)header.heuristic, (SearchAlgorithm)header.algorithm,
+                     header.lazy_heuristic != 0);
+    if (header.perimeter_radius >= 0 && !npuzzle_solver_set_perimeter(solver, header.perimeter_radius)) {
+        printf("Cannot rebuild the radius %d perimeter of checkpoint %s.\n", header.perimeter_radius, path);
+        npuzzle_solver_destroy(solver);
+        return NULL;
+    }
+
+    printf("Resuming %dx%d %s search with %s: %llu nodes stored, %lld expanded, %.1fs elapsed\n", n, n,
+           algorithm_name((SearchAlgorithm)header.algorithm), heuristic_name((HeuristicType)header.heuristic),
+           (unsigned long long)header.node_count, (long long)header.nodes_expanded, header.elapsed_seconds);
+    return solver;
+}
+
+/**
+ * Command line entry: npuzzle --solve "TILES" [--heuristic NAME] [--algorithm NAME]
+ *                                             [--lazy] [--deadline-ms MS] [--max-nodes N] [--progress K]
+ *                                             [--checkpoint FILE [--checkpoint-every SECONDS]]
+ *                                             [--encoding plain|rle|binary] [--show-boards] [--perimeter R]
+ *                     npuzzle --resume FILE [--checkpoint-every SECONDS] [--deadline-ms MS] ...
+ * A resumed search keeps checkpointing to the file it was resumed from.
+ * Solutions are verified by replaying the moves before they are printed
+ */
+int run_solve_command(int argc, char* argv[]) {
+    const char* board_text = NULL;
+    const char* heuristic = "manhattan";
+    const char* algorithm = "astar";
+    long deadline_ms = 0, max_nodes = 0, progress_interval = 0;
+    const char* checkpoint_path = NULL;
+    const char* resume_path = NULL;
+    const char* encoding_name = "plain";
+    bool show_boards = false;
+    int perimeter_radius = -1;
+    double checkpoint_seconds = DEFAULT_CHECKPOINT_SECONDS;
+    bool lazy = false;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--solve") == 0 && i + 1 < argc) {
+            board_text = argv[++i];
+        } else if (strcmp(argv[i], "--heuristic") == 0 && i + 1 < argc) {
+            heuristic = argv[++i];
+        } else if (strcmp(argv[i], "--algorithm") == 0 && i + 1 < argc) {
+            algorithm = argv[++i];
+        } else if (strcmp(argv[i], "--lazy") == 0) {
+            lazy = true;
+        } else if (strcmp(argv[i], "--deadline-ms") == 0 && i + 1 < argc) {
+            deadline_ms = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--max-nodes") == 0 && i + 1 < argc) {
+            max_nodes = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--progress") == 0 && i + 1 < argc) {
+            progress_interval = atol(argv[++i]);
+        } else if (strcmp(argv[i], "--checkpoint") == 0 && i + 1 < argc) {
+            checkpoint_path = argv[++i];
+        } else if (strcmp(argv[i], "--checkpoint-every") == 0 && i + 1 < argc) {
+            checkpoint_seconds = atof(argv[++i]);
+        } else if (strcmp(argv[i], "--resume") == 0 && i + 1 < argc) {
+            resume_path = argv[++i];
+        } else if (strcmp(argv[i], "--encoding") == 0 && i + 1 < argc) {
+            encoding_name = argv[++i];
+        } else if (strcmp(argv[i], "--show-boards") == 0) {
+            show_boards = true;
+        } else if (strcmp(argv[i], "--perimeter") == 0 && i + 1 < argc) {
+            perimeter_radius = atoi(argv[++i]);
+        } else {
+            printf("Unknown solve option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    int board[MAX_SIZE * MAX_SIZE];
+    HeuristicType heuristic_type;
+    SearchAlgorithm search_algorithm;
+    MoveEncoding encoding;
+    int n = board_text ? parse_board_string(board_text, board) : 0;
+    if ((!resume_path && n == 0) || (resume_path && board_text) ||
+        !parse_heuristic_name(heuristic, &heuristic_type) || !parse_algorithm_name(algorithm, &search_algorithm) ||
+        !parse_move_encoding(encoding_name, &encoding) || perimeter_radius < -1 ||
+        perimeter_radius > MAX_PERIMETER_RADIUS || (resume_path && perimeter_radius >= 0)) {
+        printf("Usage: npuzzle --solve \"TILES\" [--heuristic tiles|manhattan|linear] [--algorithm astar|epea]\n"
+               "                [--lazy] [--deadline-ms MS] [--max-nodes N] [--progress K]\n"
+               "                [--checkpoint FILE [--checkpoint-every SECONDS]] [--encoding plain|rle|binary]\n"
+               "                [--show-boards] [--perimeter R]\n"
+               "       npuzzle --resume FILE [--checkpoint-every SECONDS] [--deadline-ms MS] [--progress K]\n");
+        return 1;
+    }
+
+    NPuzzleSolver* solver;
+    if (resume_path) {
+        solver = create_resume_solver(resume_path, board, &n);
+        if (!solver) return 1;
+        if (!checkpoint_path) checkpoint_path = resume_path;
+    } else {
+        solver = npuzzle_solver_create(n, NULL);
+        if (!solver) {
+            printf("Cannot create solver for %dx%d boards.\n", n, n);
+            return 1;
+        }
+        configure_solver(solver, heuristic_type, search_algorithm, lazy);
+        if (perimeter_radius >= 0) {
+            double build_start = monotonic_seconds();
+            if (!npuzzle_solver_set_perimeter(solver, perimeter_radius)) {
+                printf("Cannot build a perimeter of radius %d: over %u states or out of memory\n",
+                       perimeter_radius, PERIMETER_MAX_STATES);
+                npuzzle_solver_destroy(solver);
+                return 1;
+            }
+            printf("Perimeter: radius %d built in %.3f s\n", perimeter_radius, monotonic_seconds() - build_start);
+        }
+    }
+    npuzzle_solver_set_deadline_ms(solver, deadline_ms);
+    npuzzle_solver_set_node_budget(solver, max_nodes);
+    if (progress_interval > 0) {
+        npuzzle_solver_set_progress_callback(solver, print_solve_progress, NULL, progress_interval);
+    }
+    if (checkpoint_path) {
+        if (!npuzzle_solver_set_checkpoint(solver, checkpoint_path, checkpoint_seconds)) {
+            printf("Out of memory setting up checkpoints.\n");
+            npuzzle_solver_destroy(solver);
+            return 1;
+        }
+        npuzzle_solver_set_cancel_flag(solver, &interrupt_flag);
+        signal(SIGINT, handle_solve_interrupt);
+    }
+
+    NPuzzleResult result;
+    NPuzzleStatus status = resume_path ? npuzzle_resume(solver, resume_path, &result)
+                                       : npuzzle_solve(solver, board, &result);
+    if (checkpoint_path) signal(SIGINT, SIG_DFL);
+
+    printf("Status: %s\n", npuzzle_status_string(status));
+    if ((status == NPUZZLE_DEADLINE || status == NPUZZLE_CANCELLED) && checkpoint_path) {
+        printf("Search saved to %s; continue with --resume %s\n", checkpoint_path, checkpoint_path);
+    }
+    if (status == NPUZZLE_SOLVED) {
+        printf("Moves (%d): ", result.length);
+        if (!print_moves(result.moves, result.length, encoding)) printf("(out of memory)");
+        printf("\n");
+
+        bool verified = npuzzle_verify(solver, board, result.moves);
+        printf("Verified: %s\n", verified ? "yes" : "NO");
+        if (!verified) status = NPUZZLE_NO_SOLUTION;
+
+        if (show_boards) {
+            int grid[MAX_SIZE][MAX_SIZE];
+            for (int cell = 0; cell < n * n; cell++) {
+                grid[cell / n][cell % n] = board[cell];
+            }
+            printf("\n");
+            print_move_boards(pack_state(grid, n), result.moves, result.length, n);
+        }
+    }
+    printf("Nodes expanded: %ld\n", result.stats.nodes_expanded);
+    printf("Nodes generated: %ld\n", result.stats.nodes_generated);
+    printf("Nodes stored: %ld\n", result.stats.nodes_stored);
+    printf("Peak open list: %ld\n", result.stats.peak_open);
+    printf("Time: %.3f s\n", result.stats.elapsed_seconds);
+
+    npuzzle_result_free(&result);
+    npuzzle_solver_destroy(solver);
+    return status == NPUZZLE_SOLVED ? 0 : 1;
+}
+
+/**
+ * Command line entry: npuzzle --verify "TILES" --moves MOVES [--encoding plain|rle|binary] [--length N]
+ * Replays a move string in any output encoding towards the snail goal; binary
+ * hex needs the move count, which solve prints next to the moves
+ */
+int run_verify_command(int argc, char* argv[]) {
+    const char* board_text = NULL;
+    const char* moves_text = NULL;
+    const char* encoding_name = "rle";
+    int binary_length = -1;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--verify") == 0 && i + 1 < argc) {
+            board_text = argv[++i];
+        } else if (strcmp(argv[i], "--moves") == 0 && i + 1 < argc) {
+            moves_text = argv[++i];
+        } else if (strcmp(argv[i], "--encoding") == 0 && i + 1 < argc) {
+            encoding_name = argv[++i];
+        } else if (strcmp(argv[i], "--length") == 0 && i + 1 < argc) {
+            binary_length = atoi(argv[++i]);
+        } else {
+            printf("Unknown verify option: %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    int board[MAX_SIZE * MAX_SIZE];
+    MoveEncoding encoding;
+    int n = board_text ? parse_board_string(board_text, board) : 0;
+    if (n == 0 || !moves_text || !parse_move_encoding(encoding_name, &encoding) ||
+        (encoding == MOVES_BINARY) != (binary_length >= 0)) {
+        printf("Usage: npuzzle --verify \"TILES\" --moves MOVES [--encoding plain|rle|binary] [--length N]\n"
+               "       (--length gives the move count and is required with --encoding binary)\n");
+        return 1;
+    }
+    if (!is_permutation_board(board, n)) {
+        printf("Invalid board: the tiles must be 0 to %d, each once\n", n * n - 1);
+        return 1;
+    }
+
+    // Plain move strings are valid run-length text with every count omitted
+    int length = binary_length;
+    char* moves = encoding == MOVES_BINARY ? decode_moves_hex(moves_text, length)
+                                           : decode_moves_rle(moves_text, &length);
+    if (!moves) {
+        printf("Invalid or oversized move string: %s\n", moves_text);
+        return 1;
+    }
+
+    int grid[MAX_SIZE][MAX_SIZE];
+    int goal[MAX_SIZE][MAX_SIZE];
+    for (int cell = 0; cell < n * n; cell++) {
+        grid[cell / n][cell % n] = board[cell];
+    }
+    default_goal_state(goal, n);
+
+    bool valid = verify_solution(pack_state(grid, n), pack_state(goal, n), moves, length, n);
+    printf("%s (%d moves)\n", valid ? "Valid solution" : "Invalid solution", length);
+    free(moves);
+    return valid ? 0 : 1;
+}
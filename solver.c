@@ -0,0 +1,611 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include <limits.h>
+#include <time.h>
+#include "npuzzle.h"
+
+#define NO_NODE STATE_NOT_FOUND
+#define INITIAL_NODE_CAPACITY 1024
+#define LIMIT_CHECK_INTERVAL 1024
+
+/*
+ * Quiet A* engine used by the non-interactive modes.
+ *
+ * Unlike a_star_search, which builds a printable tree of TreeNodes, this
+ * engine stores states packed into 64 bits in a flat node pool with parent
+ * links as indices, keeps the open list in a binary heap and detects
+ * duplicates with a StateIndex hash table. Heuristics are evaluated
+ * incrementally from the precomputed HeuristicTables, so nothing is
+ * rebuilt per solve and the engine never prints.
+ *
+ * With SEARCH_EPEA the engine runs Enhanced Partial Expansion A*: a node is
+ * queued under a stored value F (initially its f). Expanding it looks up
+ * the delta f of every operator in the operator table, generates only the
+ * children with f == F, and re-queues the node under the next larger child
+ * f. Children with f above the optimal cost are never created, so far fewer
+ * nodes are stored than with plain A*. Heuristics without operator tables
+ * are evaluated in full for each candidate child instead.
+ *
+ * With lazy_heuristic set, a heuristic without operator tables (linear
+ * conflict) is not evaluated when a child is generated. The child is
+ * queued under an incremental Manhattan bound, and the full heuristic is
+ * computed only when the child reaches the front of the open list. If its
+ * f rises, the child is re-queued instead of expanded.
+ *
+ * With checkpoint_path set, the node pool, open list and counters are
+ * snapshot to a file every checkpoint_interval seconds (see checkpoint.c),
+ * and once more when the search stops on its deadline or cancel flag. A
+ * search started with resume_path continues from such a snapshot. From a
+ * periodic snapshot it expands exactly the nodes the uninterrupted search
+ * would have; the final snapshot re-queues the interrupted node, which may
+ * only change the order of ties.
+ *
+ * With a perimeter (see perimeter.c) the engine runs perimeter search:
+ * children inside the ball are queued under their exact distance, every
+ * other node under at least radius + 1, and the search ends as soon as a
+ * ball node is popped, with the ball's stored tail spliced onto its path.
+ * Ball nodes are never expanded. A start inside the ball needs no search.
+ */
+
+/**
+ * Returns a monotonic timestamp in seconds
+ */
+double monotonic_seconds(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/**
+ * Returns the printable name of a search algorithm
+ */
+const char* algorithm_name(SearchAlgorithm algorithm) {
+    return algorithm == SEARCH_EPEA ? "epea" : "astar";
+}
+
+/**
+ * Parses a search algorithm name as used on the command line
+ */
+bool parse_algorithm_name(const char* name, SearchAlgorithm* algorithm) {
+    if (strcmp(name, "astar") == 0) {
+        *algorithm = SEARCH_ASTAR;
+    } else if (strcmp(name, "epea") == 0) {
+        *algorithm = SEARCH_EPEA;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Returns the printable name of a solve status
+ */
+const char* solve_status_name(SolveStatus status) {
+    switch (status) {
+        case SOLVE_FOUND:
+            return "found";
+        case SOLVE_NO_SOLUTION:
+            return "no_solution";
+        case SOLVE_NODE_LIMIT:
+            return "node_limit";
+        case SOLVE_DEADLINE:
+            return "deadline";
+        case SOLVE_CANCELLED:
+            return "cancelled";
+        case SOLVE_BAD_CHECKPOINT:
+            return "bad_checkpoint";
+        case SOLVE_OUT_OF_MEMORY:
+            return "out_of_memory";
+        default:
+            return "unknown";
+    }
+}
+
+/**
+ * Resizes an array to count elements of the given size
+ * Returns NULL if the size overflows or memory runs out; ptr is then left intact
+ */
+void* search_alloc(void* ptr, size_t count, size_t size) {
+    if (size != 0 && count > SIZE_MAX / size) return NULL;
+    return realloc(ptr, count * size);
+}
+
+/**
+ * Records an allocation failure; the search stops with SOLVE_OUT_OF_MEMORY
+ */
+bool search_out_of_memory(struct SearchSpace* space) {
+    space->out_of_memory = true;
+    return false;
+}
+
+/**
+ * Sets up an empty search space
+ * Returns false if memory runs out; the space can still be freed
+ */
+bool search_space_init(struct SearchSpace* space, const struct HeuristicTables* tables,
+                       HeuristicType heuristic_type) {
+    memset(space, 0, sizeof(*space));
+    space->tables = tables;
+    space->heuristic_type = heuristic_type;
+    space->node_capacity = INITIAL_NODE_CAPACITY;
+    space->nodes = (struct SearchNode*)search_alloc(NULL, space->node_capacity, sizeof(struct SearchNode));
+    space->open_capacity = INITIAL_NODE_CAPACITY;
+    space->open = (struct OpenEntry*)search_alloc(NULL, space->open_capacity, sizeof(struct OpenEntry));
+    bool indexed = state_index_init(&space->index, sizeof(struct SearchNode), INITIAL_NODE_CAPACITY);
+    if (!space->nodes || !indexed || !space->open) return search_out_of_memory(space);
+    return true;
+}
+
+/**
+ * Grows the node pool and open list to hold the given counts
+ * The hash index is left alone; callers rebuild it once the nodes are in place
+ * Returns false if memory runs out
+ */
+bool search_space_reserve(struct SearchSpace* space, size_t node_count, size_t open_count) {
+    size_t node_capacity = space->node_capacity;
+    size_t open_capacity = space->open_capacity;
+    while (node_capacity < node_count) node_capacity *= 2;
+    while (open_capacity < open_count) open_capacity *= 2;
+
+    struct SearchNode* nodes = (struct SearchNode*)search_alloc(space->nodes, node_capacity,
+                                                                sizeof(struct SearchNode));
+    if (!nodes) return search_out_of_memory(space);
+    space->nodes = nodes;
+    space->node_capacity = node_capacity;
+
+    struct OpenEntry* open = (struct OpenEntry*)search_alloc(space->open, open_capacity, sizeof(struct OpenEntry));
+    if (!open) return search_out_of_memory(space);
+    space->open = open;
+    space->open_capacity = open_capacity;
+    return true;
+}
+
+void search_space_free(struct SearchSpace* space) {
+    free(space->nodes);
+    state_index_free(&space->index);
+    free(space->open);
+}
+
+/**
+ * Finds the node holding a state, or NO_NODE
+ */
+uint32_t search_lookup(const struct SearchSpace* space, PackedState state) {
+    return state_index_find(&space->index, space->nodes, state);
+}
+
+/**
+ * Appends a node to the pool and indexes it, growing both as needed
+ * Returns NO_NODE if memory runs out
+ */
+uint32_t search_add_node(struct SearchSpace* space, PackedState state, int blank, uint32_t parent,
+                         int move, int g, int h, int cheap_h, bool exact) {
+    // Indices are 32 bits, with NO_NODE reserved
+    if (space->node_count >= NO_NODE) {
+        search_out_of_memory(space);
+        return NO_NODE;
+    }
+    if (space->node_count == space->node_capacity) {
+        struct SearchNode* nodes = (struct SearchNode*)search_alloc(space->nodes, 2 * space->node_capacity,
+                                                                    sizeof(struct SearchNode));
+        if (!nodes) {
+            search_out_of_memory(space);
+            return NO_NODE;
+        }
+        space->nodes = nodes;
+        space->node_capacity *= 2;
+    }
+
+    uint32_t index = (uint32_t)space->node_count;
+    struct SearchNode* node = &space->nodes[index];
+    node->state = state;
+    node->parent = parent;
+    node->g = (uint16_t)g;
+    node->h = (uint16_t)h;
+    node->blank = (uint8_t)blank;
+    node->move = (uint8_t)move;
+    node->closed = 0;
+    node->cheap_h = (uint8_t)cheap_h;
+    node->exact = exact;
+    node->in_ball = 0;
+    if (!state_index_add(&space->index, space->nodes, index)) {
+        search_out_of_memory(space);
+        return NO_NODE;
+    }
+    space->node_count++;
+    return index;
+}
+
+/**
+ * Heap order: lower f first, ties broken towards deeper nodes
+ */
+bool open_entry_before(const struct OpenEntry* a, const struct OpenEntry* b) {
+    return a->f < b->f || (a->f == b->f && a->g > b->g);
+}
+
+/**
+ * Queues a node under the given f (its g + h, or a larger EPEA* stored value)
+ * Returns false if memory runs out
+ */
+bool open_push(struct SearchSpace* space, uint32_t index, int f) {
+    if (space->open_count == space->open_capacity) {
+        struct OpenEntry* open = (struct OpenEntry*)search_alloc(space->open, 2 * space->open_capacity,
+                                                                 sizeof(struct OpenEntry));
+        if (!open) return search_out_of_memory(space);
+        space->open = open;
+        space->open_capacity *= 2;
+    }
+
+    struct OpenEntry entry = {index, (uint16_t)f, space->nodes[index].g};
+
+    size_t i = space->open_count++;
+    while (i > 0) {
+        size_t parent = (i - 1) / 2;
+        if (!open_entry_before(&entry, &space->open[parent])) break;
+        space->open[i] = space->open[parent];
+        i = parent;
+    }
+    space->open[i] = entry;
+    return true;
+}
+
+struct OpenEntry open_pop(struct SearchSpace* space) {
+    struct OpenEntry top = space->open[0];
+    struct OpenEntry last = space->open[--space->open_count];
+
+    size_t i = 0;
+    while (true) {
+        size_t child = 2 * i + 1;
+        if (child >= space->open_count) break;
+        if (child + 1 < space->open_count && open_entry_before(&space->open[child + 1], &space->open[child])) {
+            child++;
+        }
+        if (!open_entry_before(&space->open[child], &last)) break;
+        space->open[i] = space->open[child];
+        i = child;
+    }
+    if (space->open_count > 0) {
+        space->open[i] = last;
+    }
+    return top;
+}
+
+/**
+ * Rebuilds the move string by following parent links back to the root
+ * Returns false if memory runs out
+ */
+bool extract_moves(const struct SearchSpace* space, uint32_t goal_index, struct SolveResult* result) {
+    int length = space->nodes[goal_index].g;
+    result->moves = (char*)malloc((size_t)length + 1);
+    if (!result->moves) return false;
+    result->moves[length] = '\0';
+    result->length = length;
+
+    uint32_t index = goal_index;
+    for (int i = length - 1; i >= 0; i--) {
+        result->moves[i] = MOVE_CHARS[space->nodes[index].move];
+        index = space->nodes[index].parent;
+    }
+    return true;
+}
+
+/**
+ * Appends the stored perimeter tail of a ball state to a solution
+ * Returns false if memory runs out
+ */
+bool splice_perimeter_tail(const struct Perimeter* perimeter, PackedState state, struct SolveResult* result) {
+    int distance = perimeter_distance(perimeter, state);
+    char* moves = (char*)realloc(result->moves, (size_t)result->length + distance + 1);
+    if (!moves) return false;
+    result->moves = moves;
+    result->length += perimeter_tail(perimeter, state, result->moves + result->length);
+    result->moves[result->length] = '\0';
+    return true;
+}
+
+/**
+ * Heuristic value a node is queued under: the exact distance inside the
+ * perimeter, and at least radius + 1 (the floor) outside it
+ */
+int bounded_h(int h, bool in_ball, int floor) {
+    return in_ball || h >= floor ? h : floor;
+}
+
+/**
+ * Checks deadline and cancel flag and reports progress
+ * Returns true if the search must stop, with the reason in result
+ */
+bool check_search_limits(const struct SolveOptions* options, const struct SearchSpace* space,
+                         int f, double start, struct SolveResult* result) {
+    long expanded = result->nodes_expanded;
+
+    if (options->progress && options->progress_interval > 0 && expanded % options->progress_interval == 0) {
+        struct SolveProgress progress = {expanded, (long)space->open_count, f, monotonic_seconds() - start};
+        options->progress(&progress, options->progress_user_data);
+    }
+
+    if (expanded % LIMIT_CHECK_INTERVAL != 0) return false;
+
+    if (options->cancel && *options->cancel) {
+        result->status = SOLVE_CANCELLED;
+        return true;
+    }
+    if (options->deadline > 0 && monotonic_seconds() >= options->deadline) {
+        result->status = SOLVE_DEADLINE;
+        return true;
+    }
+    return false;
+}
+
+/**
+ * Copies the current counters of a search into its checkpoint header
+ */
+void fill_checkpoint_stats(struct CheckpointHeader* header, const struct SearchSpace* space,
+                           const struct SolveResult* result, double elapsed) {
+    header->node_count = space->node_count;
+    header->open_count = space->open_count;
+    header->nodes_expanded = result->nodes_expanded;
+    header->nodes_generated = result->nodes_generated;
+    header->peak_open = result->peak_open;
+    header->heuristic_evaluations = result->heuristic_evaluations;
+    header->lazy_reinsertions = result->lazy_reinsertions;
+    header->elapsed_seconds = elapsed;
+}
+
+/**
+ * Solves a puzzle optimally without printing anything
+ * When resuming from a checkpoint, initial may be NULL
+ * Returns true if a solution was found; details are stored in result
+ */
+bool solve_puzzle(const struct HeuristicTables* tables, int initial[MAX_SIZE][MAX_SIZE],
+                  HeuristicType heuristic_type, const struct SolveOptions* options,
+                  struct SolveResult* result) {
+    double start = monotonic_seconds();
+    int n = tables->n;
+    struct SearchSpace space;
+
+    memset(result, 0, sizeof(*result));
+    result->status = SOLVE_NO_SOLUTION;
+    if (!search_space_init(&space, tables, heuristic_type)) {
+        result->status = SOLVE_OUT_OF_MEMORY;
+        result->elapsed_seconds = monotonic_seconds() - start;
+        search_space_free(&space);
+        return false;
+    }
+
+    bool epea = options && options->algorithm == SEARCH_EPEA;
+    const struct Perimeter* perimeter = options ? options->perimeter : NULL;
+    int h_floor = perimeter ? perimeter->radius + 1 : 0;
+    struct CheckpointHeader checkpoint;
+    memset(&checkpoint, 0, sizeof(checkpoint));
+
+    if (options && options->resume_path) {
+        // The snapshot must come from a search with the same goal and settings
+        if (!load_checkpoint(options->resume_path, &space, &checkpoint) || checkpoint.n != (uint32_t)n ||
+            checkpoint.goal != tables->goal || checkpoint.heuristic != (uint32_t)heuristic_type ||
+            checkpoint.algorithm != (uint32_t)(epea ? SEARCH_EPEA : SEARCH_ASTAR) ||
+            checkpoint.lazy_heuristic != (uint32_t)options->lazy_heuristic ||
+            checkpoint.perimeter_radius != (perimeter ? perimeter->radius : -1) ||
+            (initial && checkpoint.initial != pack_state(initial, n))) {
+            result->status = space.out_of_memory ? SOLVE_OUT_OF_MEMORY : SOLVE_BAD_CHECKPOINT;
+            result->elapsed_seconds = monotonic_seconds() - start;
+            search_space_free(&space);
+            return false;
+        }
+        result->nodes_expanded = (long)checkpoint.nodes_expanded;
+        result->nodes_generated = (long)checkpoint.nodes_generated;
+        result->peak_open = (long)checkpoint.peak_open;
+        result->heuristic_evaluations = (long)checkpoint.heuristic_evaluations;
+        result->lazy_reinsertions = (long)checkpoint.lazy_reinsertions;
+        start -= checkpoint.elapsed_seconds;
+    } else {
+        // Parity mismatch: the goal is unreachable, no need to exhaust the space
+        int goal[MAX_SIZE][MAX_SIZE];
+        unpack_state(tables->goal, goal, n);
+        if (!is_solvable(initial, goal, n)) {
+            result->elapsed_seconds = monotonic_seconds() - start;
+            search_space_free(&space);
+            return false;
+        }
+
+        // Starts inside the perimeter are answered by lookup alone
+        PackedState root_state = pack_state(initial, n);
+        if (perimeter && perimeter_distance(perimeter, root_state) >= 0) {
+            bool spliced = splice_perimeter_tail(perimeter, root_state, result);
+            result->status = spliced ? SOLVE_FOUND : SOLVE_OUT_OF_MEMORY;
+            result->elapsed_seconds = monotonic_seconds() - start;
+            search_space_free(&space);
+            return spliced;
+        }
+
+        // The initial pool always has room for the root
+        uint32_t root = search_add_node(&space, root_state, packed_blank_cell(root_state, n), NO_NODE,
+                                        NO_MOVE, 0, packed_heuristic(tables, root_state, heuristic_type),
+                                        packed_heuristic(tables, root_state, MANHATTAN_DISTANCE), true);
+        open_push(&space, root, bounded_h(space.nodes[root].h, false, h_floor));
+
+        memcpy(checkpoint.magic, CHECKPOINT_MAGIC, sizeof(checkpoint.magic));
+        checkpoint.version = CHECKPOINT_VERSION;
+        checkpoint.header_size = sizeof(checkpoint);
+        checkpoint.n = (uint32_t)n;
+        checkpoint.heuristic = (uint32_t)heuristic_type;
+        checkpoint.algorithm = (uint32_t)(epea ? SEARCH_EPEA : SEARCH_ASTAR);
+        checkpoint.lazy_heuristic = options && options->lazy_heuristic;
+        checkpoint.node_size = sizeof(struct SearchNode);
+        checkpoint.open_entry_size = sizeof(struct OpenEntry);
+        checkpoint.perimeter_radius = perimeter ? perimeter->radius : -1;
+        checkpoint.initial = root_state;
+        checkpoint.goal = tables->goal;
+    }
+
+    bool checkpointing = options && options->checkpoint_path;
+    struct CheckpointWriter writer = {0, 0};
+    long checked_at = result->nodes_expanded;
+    double next_checkpoint = checkpointing ? monotonic_seconds() + options->checkpoint_interval : 0;
+
+    // Table-driven heuristics are updated incrementally per move; others
+    // need a full evaluation, which lazy mode defers until a node is popped
+    bool table_driven = heuristic_type < NUM_TABLE_HEURISTICS;
+    bool lazy = options && options->lazy_heuristic && !table_driven && !epea;
+    const signed char (*manhattan_delta)[NUM_MOVES][MAX_SIZE * MAX_SIZE] =
+        tables->operator_delta_f[MANHATTAN_DISTANCE];
+
+    while (space.open_count > 0 && !space.out_of_memory) {
+        // Between expansions every queued node has its open entry, so the
+        // search can be snapshot as is
+        if (checkpointing && result->nodes_expanded - checked_at >= LIMIT_CHECK_INTERVAL) {
+            checked_at = result->nodes_expanded;
+            if (monotonic_seconds() >= next_checkpoint) {
+                fill_checkpoint_stats(&checkpoint, &space, result, monotonic_seconds() - start);
+                start_checkpoint(&writer, options->checkpoint_path, &checkpoint, &space);
+                next_checkpoint = monotonic_seconds() + options->checkpoint_interval;
+            }
+        }
+
+        struct OpenEntry entry = open_pop(&space);
+        struct SearchNode current = space.nodes[entry.node];
+        if (current.closed || entry.g != current.g) continue;
+
+        if (!current.exact) {
+            int h = packed_heuristic(tables, current.state, heuristic_type);
+            result->heuristic_evaluations++;
+            space.nodes[entry.node].exact = 1;
+            if (h > current.h) {
+                space.nodes[entry.node].h = (uint16_t)h;
+                int f = current.g + bounded_h(h, false, h_floor);
+                if (f > entry.f) {
+                    open_push(&space, entry.node, f);
+                    result->lazy_reinsertions++;
+                    continue;
+                }
+            }
+        }
+
+        // A ball node popped with the smallest f completes an optimal
+        // solution: the path to it plus its stored tail
+        if (current.in_ball || current.state == tables->goal) {
+            result->status = SOLVE_FOUND;
+            if (!extract_moves(&space, entry.node, result) ||
+                (current.in_ball && !splice_perimeter_tail(perimeter, current.state, result))) {
+                free_solve_result(result);
+                result->status = SOLVE_OUT_OF_MEMORY;
+            }
+            break;
+        }
+
+        if (options && check_search_limits(options, &space, entry.f, start, result)) {
+            // Put the node back so that a resumed search expands it first
+            if (checkpointing && open_push(&space, entry.node, entry.f)) {
+                finish_checkpoint(&writer, true);
+                fill_checkpoint_stats(&checkpoint, &space, result, monotonic_seconds() - start);
+                if (write_checkpoint_file(options->checkpoint_path, &checkpoint, &space)) writer.completed++;
+            }
+            break;
+        }
+
+        result->nodes_expanded++;
+
+        // EPEA* generates only the children whose f equals the stored value
+        // and remembers the next larger delta f to re-queue the node with
+        const signed char (*delta_f)[MAX_SIZE * MAX_SIZE] =
+            tables->operator_delta_f[table_driven ? heuristic_type : MANHATTAN_DISTANCE][current.blank];
+        int current_h = bounded_h(current.h, false, h_floor);
+        int wanted_delta = entry.f - (current.g + current_h);
+        int next_delta = INT_MAX;
+
+        for (int dir = 0; dir < NUM_MOVES; dir++) {
+            PackedState next;
+            int next_blank;
+            if (!packed_move(current.state, current.blank, dir, n, &next, &next_blank)) continue;
+
+            int tile = (int)((current.state >> (4 * next_blank)) & 0xF);
+            int cheap_h = current.cheap_h + manhattan_delta[current.blank][dir][tile] - 1;
+            int h;
+            int ball_distance = perimeter ? perimeter_distance(perimeter, next) : -1;
+            if (ball_distance >= 0) {
+                h = ball_distance;
+            } else if (table_driven) {
+                h = current.h + delta_f[dir][tile] - 1;
+            } else if (lazy) {
+                // Both bounds are admissible: Manhattan, and the parent's h
+                // less the one move separating them
+                h = cheap_h > current.h - 1 ? cheap_h : current.h - 1;
+            } else if (epea) {
+                h = packed_heuristic(tables, next, heuristic_type);
+                result->heuristic_evaluations++;
+            } else {
+                h = -1;              // Evaluated below, only if the state is new
+            }
+
+            int delta = 1 + bounded_h(h, ball_distance >= 0, h_floor) - current_h;
+            if (epea && delta != wanted_delta) {
+                if (delta > wanted_delta && delta < next_delta) next_delta = delta;
+                continue;
+            }
+
+            int g = current.g + 1;
+            uint32_t existing = search_lookup(&space, next);
+            if (existing != NO_NODE) {
+                // Reopen only if this path is strictly cheaper
+                struct SearchNode* node = &space.nodes[existing];
+                if (node->g <= g) continue;
+                node->g = (uint16_t)g;
+                node->parent = entry.node;
+                node->move = (uint8_t)dir;
+                node->closed = 0;
+                open_push(&space, existing, g + bounded_h(node->h, node->in_ball, h_floor));
+                result->nodes_generated++;
+                continue;
+            }
+
+            if (options && options->max_nodes > 0 && (long)space.node_count >= options->max_nodes) {
+                result->status = SOLVE_NODE_LIMIT;
+                space.open_count = 0;
+                break;
+            }
+
+            if (h < 0) {
+                h = packed_heuristic(tables, next, heuristic_type);
+                result->heuristic_evaluations++;
+            }
+            bool in_ball = ball_distance >= 0;
+            uint32_t child = search_add_node(&space, next, next_blank, entry.node, dir, g, h, cheap_h,
+                                             !lazy || in_ball);
+            if (child == NO_NODE) break;
+            space.nodes[child].in_ball = in_ball;
+            open_push(&space, child, g + bounded_h(h, in_ball, h_floor));
+            result->nodes_generated++;
+        }
+
+        if (epea && next_delta != INT_MAX && result->status != SOLVE_NODE_LIMIT) {
+            open_push(&space, entry.node, current.g + current_h + next_delta);
+        } else {
+            space.nodes[entry.node].closed = 1;
+        }
+
+        if ((long)space.open_count > result->peak_open) {
+            result->peak_open = (long)space.open_count;
+        }
+    }
+
+    if (space.out_of_memory) {
+        result->status = SOLVE_OUT_OF_MEMORY;
+    }
+    result->memory_bytes = space.node_capacity * sizeof(struct SearchNode) +
+                           state_index_bytes(&space.index) +
+                           space.open_capacity * sizeof(struct OpenEntry);
+    result->nodes_stored = (long)space.node_count;
+    finish_checkpoint(&writer, true);
+    result->checkpoints_written = writer.completed;
+    result->elapsed_seconds = monotonic_seconds() - start;
+    search_space_free(&space);
+    return result->status == SOLVE_FOUND;
+}
+
+/**
+ * Releases memory owned by a solve result
+ */
+void free_solve_result(struct SolveResult* result) {
+    free(result->moves);
+    result->moves = NULL;
+    result->length = 0;
+}
@@ -0,0 +1,110 @@
+#include "npuzzle.h"
+
+/*
+ * Hash index over an array of records that each start with a PackedState.
+ *
+ * The records themselves live in the owner's array (the search node pool,
+ * the perimeter's state list); the index only keeps open-addressing slots
+ * holding record index + 1, with 0 for an empty slot, probed linearly.
+ * The array may move between calls, so every call takes its current
+ * address. The table is kept at most half full.
+ */
+
+#define STATE_INDEX_MIN_SLOTS 16
+
+uint64_t hash_packed_state(PackedState state) {
+    // splitmix64 finalizer
+    state ^= state >> 30;
+    state *= 0xbf58476d1ce4e5b9ULL;
+    state ^= state >> 27;
+    state *= 0x94d049bb133111ebULL;
+    state ^= state >> 31;
+    return state;
+}
+
+PackedState state_index_record(const struct StateIndex* index, const void* records, uint32_t record) {
+    return *(const PackedState*)((const char*)records + (size_t)record * index->stride);
+}
+
+void state_index_insert(struct StateIndex* index, const void* records, uint32_t record) {
+    size_t slot = hash_packed_state(state_index_record(index, records, record)) & index->slot_mask;
+    while (index->slots[slot] != 0) {
+        slot = (slot + 1) & index->slot_mask;
+    }
+    index->slots[slot] = record + 1;
+}
+
+/**
+ * Sets up an empty index for records of the given size with room for capacity of them
+ * Returns false if memory runs out; the index can still be freed
+ */
+bool state_index_init(struct StateIndex* index, size_t stride, size_t capacity) {
+    index->slots = NULL;
+    index->slot_mask = 0;
+    index->stride = stride;
+    return state_index_resize(index, NULL, 0, capacity);
+}
+
+void state_index_free(struct StateIndex* index) {
+    free(index->slots);
+    index->slots = NULL;
+    index->slot_mask = 0;
+}
+
+/**
+ * Rebuilds the table with room for capacity records and indexes the first count of them
+ * Returns false, leaving the index unchanged, if memory runs out
+ */
+bool state_index_resize(struct StateIndex* index, const void* records, size_t count, size_t capacity) {
+    // Record indices are stored plus one in 32 bits
+    if (capacity < count || capacity >= STATE_NOT_FOUND) return false;
+
+    size_t slot_count = STATE_INDEX_MIN_SLOTS;
+    while (slot_count < 2 * capacity) slot_count *= 2;
+
+    uint32_t* slots = (uint32_t*)calloc(slot_count, sizeof(uint32_t));
+    if (!slots) return false;
+    free(index->slots);
+    index->slots = slots;
+    index->slot_mask = slot_count - 1;
+    for (size_t i = 0; i < count; i++) {
+        state_index_insert(index, records, (uint32_t)i);
+    }
+    return true;
+}
+
+/**
+ * Indexes a newly appended record; every record before it must already be indexed
+ * Returns false if the table had to grow and memory ran out
+ */
+bool state_index_add(struct StateIndex* index, const void* records, uint32_t record) {
+    // Keep the hash table at most half full
+    if (2 * ((size_t)record + 1) > index->slot_mask + 1 &&
+        !state_index_resize(index, records, record, (size_t)record + 1)) {
+        return false;
+    }
+    state_index_insert(index, records, record);
+    return true;
+}
+
+/**
+ * Finds the record holding a state, or STATE_NOT_FOUND
+ */
+uint32_t state_index_find(const struct StateIndex* index, const void* records, PackedState state) {
+    size_t slot = hash_packed_state(state) & index->slot_mask;
+    while (index->slots[slot] != 0) {
+        uint32_t record = index->slots[slot] - 1;
+        if (state_index_record(index, records, record) == state) {
+            return record;
+        }
+        slot = (slot + 1) & index->slot_mask;
+    }
+    return STATE_NOT_FOUND;
+}
+
+/**
+ * Bytes held by the table
+ */
+size_t state_index_bytes(const struct StateIndex* index) {
+    return index->slots ? (index->slot_mask + 1) * sizeof(uint32_t) : 0;
+}